@@ -3,11 +3,33 @@
 #include "DiceCalculator/Controllers/ExpressionEvaluationController.h"
 #include "DiceCalculator/Evaluation/ConvolutionAstVisitor.h"
 #include "DiceCalculator/Evaluation/CombinationAstVisitor.h"
+#include "DiceCalculator/Evaluation/ParallelRollSampler.h"
 #include "DiceCalculator/Evaluation/RollAstVisitor.h"
+#include "DiceCalculator/Evaluation/RollProgramCompiler.h"
 #include "DiceCalculator/Expressions/DiceAst.h"
+#include "DiceCalculator/ThreadPool.h"
+#include "DiceCalculator/Transforms/AlgebraicSimplifier.h"
+#include "DiceCalculator/Transforms/AssociativeFlattener.h"
 
 namespace DiceCalculator::Controllers
 {
+	namespace
+	{
+		// Shared by all controllers so that several expression blocks do not each spawn a full set of workers.
+		std::shared_ptr<ThreadPool> GetEvaluationThreadPool()
+		{
+			static std::shared_ptr<ThreadPool> pool = std::make_shared<ThreadPool>();
+			return pool;
+		}
+
+		// Shared for the same reason: blocks often repeat sub-expressions such as `1d20 + 5`.
+		std::shared_ptr<Evaluation::DistributionCache> GetDistributionCache()
+		{
+			static std::shared_ptr<Evaluation::DistributionCache> cache = std::make_shared<Evaluation::DistributionCache>();
+			return cache;
+		}
+	}
+
 	ExpressionEvaluationController::ExpressionEvaluationController(std::shared_ptr<Parsing::IParser> parser, QObject* parent) :
 		m_Parser(std::move(parser)), QObject(parent)
 	{
@@ -48,7 +70,7 @@ namespace DiceCalculator::Controllers
 			emit ParsingMessage(expression, "Parsing OK", MessageType::Info);
 			emit ParsingFinished(expression);
 
-			EvaluateExpressionInternalWrapper(ast, method, expression);
+			EvaluateExpressionInternalWrapper(Transforms::AssociativeFlattener::Flatten(Transforms::AlgebraicSimplifier::Simplify(ast)), method, expression);
 		}
 		catch (const std::runtime_error& error)
 		{
@@ -153,27 +175,43 @@ namespace DiceCalculator::Controllers
 		Distribution dist;
 		if (method == EvaluationMethod::Convolution)
 		{
-			Evaluation::ConvolutionAstVisitor visitor;
+			Evaluation::ConvolutionAstVisitor visitor(Evaluation::Convolver(), GetEvaluationThreadPool(), GetDistributionCache());
 			ast->Accept(visitor);
 			dist = visitor.GetDistribution();
 		}
 		else if (method == EvaluationMethod::Combinatorial)
 		{
-			Evaluation::CombinationAstVisitor visitor;
+			// Only the distribution is shown, so each multiset of dice faces is enumerated once.
+			Evaluation::CombinationAstVisitor visitor(Evaluation::CombinationAstVisitor::Counting::Multisets, GetEvaluationThreadPool(), CombinatorialMaxCombinations);
 			ast->Accept(visitor);
-			auto combinations = visitor.GetCombinations();
-			dist = Distribution::FromCombinations(combinations);
+			dist = visitor.GetDistribution();
 		}
 		else if(method == EvaluationMethod::Roll)
 		{
-			Evaluation::RollAstVisitor visitor(m_Random);
-			for (int i = 0; i < MaxRollsForRollMethod; ++i)
+			// A fresh seed per evaluation; the sample itself does not depend on the pool's thread count.
+			const auto seed = static_cast<std::uint64_t>(m_Random.NextInt(0, std::numeric_limits<int>::max()));
+			if (!m_RollProgram || !m_RollProgramAst->IsEqual(*ast))
 			{
-				ast->Accept(visitor);
-				int result = visitor.GetResult();
-				dist.AddOutcome(result, 1.0);
+				m_RollProgram = std::make_shared<const Evaluation::RollProgram>(Evaluation::RollProgramCompiler::Compile(*ast));
+				m_RollProgramAst = ast;
 			}
-			dist.Normalize();
+
+			Evaluation::ParallelRollSampler sampler(seed, GetEvaluationThreadPool());
+			Evaluation::ParallelRollSampler::Precision precision;
+			precision.MaxStandardError = RollMaxStandardError;
+			precision.TimeBudget = RollTimeBudget;
+			const auto estimate = sampler.SampleAdaptive(*m_RollProgram, precision);
+			dist = estimate.Result;
+
+			emit EvaluationMessage(
+				originalExpression,
+				QString("Rolled %1 times; standard error at most %2%, CDF distance at most %3% (95% confidence)%4")
+				.arg(static_cast<qulonglong>(estimate.Samples))
+				.arg(estimate.MaxStandardError * 100.0, 0, 'g', 2)
+				.arg(estimate.KsDistance * 100.0, 0, 'g', 2)
+				.arg(estimate.PrecisionMet ? QString() : QString("; stopped before reaching the target precision")),
+				estimate.PrecisionMet ? MessageType::Info : MessageType::Warning
+			);
 		}
 		else
 		{
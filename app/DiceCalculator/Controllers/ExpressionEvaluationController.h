@@ -1,7 +1,11 @@
 #pragma once
 
 #include <QObject>
+#include <chrono>
+#include <cstdint>
 #include "DiceCalculator/Distribution.h"
+#include "DiceCalculator/Evaluation/CombinationAstVisitor.h"
+#include "DiceCalculator/Evaluation/RollProgram.h"
 #include "DiceCalculator/Parsing/IParser.h"
 #include "DiceCalculator/StdRandom.h"
 
@@ -46,11 +50,23 @@ namespace DiceCalculator::Controllers
 		void BusyStateChanged(bool isBusy);
 
 	private:
-		constexpr static int MaxRollsForRollMethod = 10000;
+		// The Roll method samples until the standard error of every outcome's probability is at most 0.1
+		// percentage points, or until the time budget is spent.
+		constexpr static double RollMaxStandardError = 0.001;
+		constexpr static std::chrono::seconds RollTimeBudget{ 2 };
+
+		// The Combinatorial method refuses expressions with more combinations than this, so that Auto
+		// falls back to Roll instead of enumerating for hours.
+		constexpr static std::uint64_t CombinatorialMaxCombinations = Evaluation::CombinationAstVisitor::DefaultMaxStreamedCombinations;
 
 		bool m_Busy = false;
 		StdRandom m_Random;
 
+		// The last expression rolled with the Roll method and its compiled program, so that re-rolling the
+		// same expression skips the compiler.
+		std::shared_ptr<const DiceCalculator::Expressions::DiceAst> m_RollProgramAst;
+		std::shared_ptr<const Evaluation::RollProgram> m_RollProgram;
+
 		std::shared_ptr<Parsing::IParser> m_Parser;
 		void EvaluateExpressionInternalWrapper(std::shared_ptr<DiceCalculator::Expressions::DiceAst> ast, EvaluationMethod method, const QString& originalExpression);
 		void EvaluateExpressionInternal(std::shared_ptr<DiceCalculator::Expressions::DiceAst> ast, EvaluationMethod method, const QString& originalExpression);
@@ -0,0 +1,51 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "DiceCalculator/Evaluation/CombinationAstVisitor.h"
+#include "DiceCalculator/Expressions/DiceNode.h"
+#include "DiceCalculator/Expressions/OperatorNode.h"
+#include "DiceCalculator/Operators/Addition.h"
+#include "DiceCalculator/Operators/Comparison.h"
+#include "DiceCalculator/ThreadPool.h"
+
+namespace DiceCalculator::Evaluation
+{
+	namespace
+	{
+		// 1d20 + 3d6 >= 2d10 + 1d8: 20 * 216 * 100 * 8 = 3,456,000 sequences through two products.
+		constexpr std::int64_t ComparisonSequences = 3456000;
+
+		std::shared_ptr<Expressions::DiceAst> CreateComparison()
+		{
+			using Expressions::DiceNode;
+			using Expressions::OperatorNode;
+			using Operands = std::vector<std::shared_ptr<Expressions::DiceAst>>;
+			auto left = std::make_shared<OperatorNode>(std::make_shared<Operators::Addition>(),
+				Operands{ std::make_shared<DiceNode>(1, 20), std::make_shared<DiceNode>(3, 6) });
+			auto right = std::make_shared<OperatorNode>(std::make_shared<Operators::Addition>(),
+				Operands{ std::make_shared<DiceNode>(2, 10), std::make_shared<DiceNode>(1, 8) });
+			return std::make_shared<OperatorNode>(std::make_shared<Operators::Comparison>(Operators::Comparison::Mode::GreaterThanOrEqual), Operands{ left, right });
+		}
+
+		// Folds every sequence of the comparison into a distribution on state.range(0) pool threads, or
+		// on the calling thread alone for 0. Items per second against the thread count give the scaling.
+		void BM_CombinationDistribution(benchmark::State& state)
+		{
+			const auto node = CreateComparison();
+			const auto threads = static_cast<std::size_t>(state.range(0));
+			auto pool = threads > 0 ? std::make_shared<ThreadPool>(threads) : nullptr;
+			CombinationAstVisitor visitor(CombinationAstVisitor::Counting::Sequences, pool);
+			node->Accept(visitor);
+
+			for (auto _ : state)
+			{
+				benchmark::DoNotOptimize(visitor.GetDistribution());
+			}
+			state.SetItemsProcessed(state.iterations() * ComparisonSequences);
+		}
+	}
+
+	BENCHMARK(BM_CombinationDistribution)->Arg(0)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Arg(16)->UseRealTime()->Unit(benchmark::kMillisecond);
+}
@@ -0,0 +1,76 @@
+#include <benchmark/benchmark.h>
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include "DiceCalculator/Evaluation/ConvolutionKernels.h"
+#include "DiceCalculator/Evaluation/Convolver.h"
+
+namespace DiceCalculator::Evaluation
+{
+	namespace
+	{
+		// Convolves two uniform arrays of state.range(0) slots each with the given kernel.
+		void BM_DirectKernel(benchmark::State& state, ConvolutionKernels::InstructionSet instructionSet)
+		{
+			const auto kernel = ConvolutionKernels::GetDirectKernel(instructionSet);
+			if (kernel == nullptr)
+			{
+				state.SkipWithError("Instruction set is not supported on this CPU.");
+				return;
+			}
+
+			const std::size_t size = static_cast<std::size_t>(state.range(0));
+			std::vector<double> lhs(size, 1.0 / static_cast<double>(size));
+			std::vector<double> rhs(size, 1.0 / static_cast<double>(size));
+			std::vector<double> result(2 * size - 1);
+
+			for (auto _ : state)
+			{
+				std::fill(result.begin(), result.end(), 0.0);
+				kernel(lhs.data(), size, rhs.data(), size, result.data());
+				benchmark::DoNotOptimize(result.data());
+				benchmark::ClobberMemory();
+			}
+			state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(size * size));
+		}
+
+		// Full Convolver::Add with the FFT disabled, i.e. what the direct path costs end to end.
+		void BM_ConvolverAddDirect(benchmark::State& state)
+		{
+			const std::size_t size = static_cast<std::size_t>(state.range(0));
+			const Distribution d = Distribution::FromDense(1, std::vector<double>(size, 1.0 / static_cast<double>(size)));
+			Convolver::Settings settings;
+			settings.FftThreshold = SIZE_MAX;
+			const Convolver convolver(settings);
+
+			for (auto _ : state)
+			{
+				benchmark::DoNotOptimize(convolver.Add(d, d));
+			}
+			state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(size * size));
+		}
+
+		void BM_ConvolverAddFft(benchmark::State& state)
+		{
+			const std::size_t size = static_cast<std::size_t>(state.range(0));
+			const Distribution d = Distribution::FromDense(1, std::vector<double>(size, 1.0 / static_cast<double>(size)));
+			Convolver::Settings settings;
+			settings.FftThreshold = 1;
+			const Convolver convolver(settings);
+
+			for (auto _ : state)
+			{
+				benchmark::DoNotOptimize(convolver.Add(d, d));
+			}
+			state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(size * size));
+		}
+	}
+
+	BENCHMARK_CAPTURE(BM_DirectKernel, Scalar, ConvolutionKernels::InstructionSet::Scalar)->RangeMultiplier(10)->Range(10, 10000);
+	BENCHMARK_CAPTURE(BM_DirectKernel, Sse2, ConvolutionKernels::InstructionSet::Sse2)->RangeMultiplier(10)->Range(10, 10000);
+	BENCHMARK_CAPTURE(BM_DirectKernel, Avx2, ConvolutionKernels::InstructionSet::Avx2)->RangeMultiplier(10)->Range(10, 10000);
+	BENCHMARK_CAPTURE(BM_DirectKernel, Avx512, ConvolutionKernels::InstructionSet::Avx512)->RangeMultiplier(10)->Range(10, 10000);
+	BENCHMARK(BM_ConvolverAddDirect)->RangeMultiplier(10)->Range(10, 10000);
+	BENCHMARK(BM_ConvolverAddFft)->RangeMultiplier(10)->Range(10, 10000);
+}
@@ -0,0 +1,93 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "DiceCalculator/Evaluation/RollAstVisitor.h"
+#include "DiceCalculator/Evaluation/RollProgramCompiler.h"
+#include "DiceCalculator/Expressions/ConstantNode.h"
+#include "DiceCalculator/Expressions/DiceNode.h"
+#include "DiceCalculator/Expressions/OperatorNode.h"
+#include "DiceCalculator/Operators/Addition.h"
+#include "DiceCalculator/Operators/Advantage.h"
+#include "DiceCalculator/Operators/AttackRoll.h"
+#include "DiceCalculator/Xoshiro128x8Random.h"
+#include "DiceCalculator/Xoshiro256Random.h"
+
+namespace DiceCalculator::Evaluation
+{
+	namespace
+	{
+		// AttackRoll(Adv(1d20) + 5, 15) + 2d6 + 1d8 + 3: a typical attack with damage dice.
+		std::shared_ptr<Expressions::DiceAst> CreateAttack()
+		{
+			using Expressions::ConstantNode;
+			using Expressions::DiceNode;
+			using Expressions::OperatorNode;
+			auto advantage = std::make_shared<OperatorNode>(std::make_shared<Operators::Advantage>(Operators::Advantage::Mode::Advantage),
+				std::vector<std::shared_ptr<Expressions::DiceAst>>{ std::make_shared<DiceNode>(1, 20) });
+			auto attack = std::make_shared<OperatorNode>(std::make_shared<Operators::Addition>(),
+				std::vector<std::shared_ptr<Expressions::DiceAst>>{ advantage, std::make_shared<ConstantNode>(5) });
+			auto attackRoll = std::make_shared<OperatorNode>(std::make_shared<Operators::AttackRoll>(),
+				std::vector<std::shared_ptr<Expressions::DiceAst>>{ attack, std::make_shared<ConstantNode>(15) });
+			return std::make_shared<OperatorNode>(std::make_shared<Operators::Addition>(),
+				std::vector<std::shared_ptr<Expressions::DiceAst>>{ attackRoll, std::make_shared<DiceNode>(2, 6), std::make_shared<DiceNode>(1, 8), std::make_shared<ConstantNode>(3) });
+		}
+
+		// Rolls a batch of state.range(0) samples with the compiled program.
+		void BM_RollProgram(benchmark::State& state)
+		{
+			const RollProgram program = RollProgramCompiler::Compile(*CreateAttack());
+			Xoshiro128x8Random random(42);
+			RollProgram::Workspace workspace;
+			std::vector<int> results(static_cast<std::size_t>(state.range(0)));
+
+			for (auto _ : state)
+			{
+				program.Run(random, results, workspace);
+				benchmark::DoNotOptimize(results.data());
+				benchmark::ClobberMemory();
+			}
+			state.SetItemsProcessed(state.iterations() * state.range(0));
+		}
+
+		// Rolls DefaultBatchSize samples of a plain state.range(0)d(state.range(1)) sum with the compiled
+		// program, i.e. one SumDice call per batch. Items are samples, so items per second is the
+		// single-core sampling throughput.
+		void BM_DiceSumProgram(benchmark::State& state)
+		{
+			const Expressions::DiceNode node(static_cast<int>(state.range(0)), static_cast<int>(state.range(1)));
+			const RollProgram program = RollProgramCompiler::Compile(node);
+			Xoshiro128x8Random random(42);
+			RollProgram::Workspace workspace;
+			std::vector<int> results(RollProgram::DefaultBatchSize);
+
+			for (auto _ : state)
+			{
+				program.Run(random, results, workspace);
+				benchmark::DoNotOptimize(results.data());
+				benchmark::ClobberMemory();
+			}
+			state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(results.size()));
+		}
+
+		// The same sum rolled one sample at a time by walking the AST, as the baseline.
+		void BM_DiceSumRollAstVisitor(benchmark::State& state)
+		{
+			const Expressions::DiceNode node(static_cast<int>(state.range(0)), static_cast<int>(state.range(1)));
+			Xoshiro256Random random(42);
+			RollAstVisitor visitor(random, RollAstVisitor::Tracking::TotalsOnly);
+
+			for (auto _ : state)
+			{
+				node.Accept(visitor);
+				benchmark::DoNotOptimize(visitor.GetResult());
+			}
+			state.SetItemsProcessed(state.iterations());
+		}
+	}
+
+	BENCHMARK(BM_RollProgram)->RangeMultiplier(8)->Range(64, 4096);
+	BENCHMARK(BM_DiceSumProgram)->Args({ 1, 20 })->Args({ 3, 6 })->Args({ 10, 6 });
+	BENCHMARK(BM_DiceSumRollAstVisitor)->Args({ 1, 20 })->Args({ 3, 6 })->Args({ 10, 6 });
+}
@@ -0,0 +1,106 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "DiceCalculator/Expressions/ConstantNode.h"
+#include "DiceCalculator/Expressions/DiceNode.h"
+#include "DiceCalculator/Expressions/FlatAst.h"
+#include "DiceCalculator/Expressions/OperatorNode.h"
+#include "DiceCalculator/Operators/Addition.h"
+
+namespace DiceCalculator::Expressions
+{
+	namespace
+	{
+		// A generated left-deep sum of `terms` dice and constants, every node allocated on its own.
+		std::shared_ptr<DiceAst> CreateSum(std::size_t terms)
+		{
+			std::shared_ptr<DiceAst> node = std::make_shared<DiceNode>(1, 6);
+			for (std::size_t i = 1; i < terms; ++i)
+			{
+				std::shared_ptr<DiceAst> leaf = i % 2 == 0
+					? std::shared_ptr<DiceAst>(std::make_shared<ConstantNode>(static_cast<int>(i)))
+					: std::shared_ptr<DiceAst>(std::make_shared<DiceNode>(1, 4 + static_cast<int>(i % 8)));
+				node = std::make_shared<OperatorNode>(std::make_shared<Operators::Addition>(), std::vector<std::shared_ptr<DiceAst>>{ node, leaf });
+			}
+			return node;
+		}
+
+		std::int64_t CountRolls(const DiceAst& ast)
+		{
+			if (const auto* dice = dynamic_cast<const DiceNode*>(&ast))
+			{
+				return dice->GetRolls();
+			}
+			std::int64_t rolls = 0;
+			if (const auto* operatorNode = dynamic_cast<const OperatorNode*>(&ast))
+			{
+				for (const auto& operand : operatorNode->GetOperands())
+				{
+					rolls += CountRolls(*operand);
+				}
+			}
+			return rolls;
+		}
+
+		// Items are nodes, so the rates of the tree and the flat copy compare directly.
+		void BM_DestroyTree(benchmark::State& state)
+		{
+			const auto terms = static_cast<std::size_t>(state.range(0));
+			for (auto _ : state)
+			{
+				state.PauseTiming();
+				auto ast = CreateSum(terms);
+				state.ResumeTiming();
+				ast.reset();
+			}
+			state.SetItemsProcessed(state.iterations() * (2 * state.range(0) - 1));
+		}
+
+		void BM_DestroyFlatAst(benchmark::State& state)
+		{
+			const auto ast = CreateSum(static_cast<std::size_t>(state.range(0)));
+			for (auto _ : state)
+			{
+				state.PauseTiming();
+				auto flat = std::make_unique<FlatAst>(*ast);
+				state.ResumeTiming();
+				flat.reset();
+			}
+			state.SetItemsProcessed(state.iterations() * (2 * state.range(0) - 1));
+		}
+
+		void BM_TraverseTree(benchmark::State& state)
+		{
+			const auto ast = CreateSum(static_cast<std::size_t>(state.range(0)));
+			for (auto _ : state)
+			{
+				benchmark::DoNotOptimize(CountRolls(*ast));
+			}
+			state.SetItemsProcessed(state.iterations() * (2 * state.range(0) - 1));
+		}
+
+		void BM_TraverseFlatAst(benchmark::State& state)
+		{
+			const FlatAst flat(*CreateSum(static_cast<std::size_t>(state.range(0))));
+			for (auto _ : state)
+			{
+				std::int64_t rolls = 0;
+				for (const auto& node : flat.GetNodes())
+				{
+					rolls += node.Kind == FlatAst::NodeKind::Dice ? node.Value : 0;
+				}
+				benchmark::DoNotOptimize(rolls);
+			}
+			state.SetItemsProcessed(state.iterations() * (2 * state.range(0) - 1));
+		}
+	}
+
+	// Deeper chains would overflow the stack in the recursive destructors of the tree.
+	BENCHMARK(BM_DestroyTree)->RangeMultiplier(10)->Range(100, 10000);
+	BENCHMARK(BM_DestroyFlatAst)->RangeMultiplier(10)->Range(100, 10000);
+	BENCHMARK(BM_TraverseTree)->RangeMultiplier(10)->Range(100, 10000);
+	BENCHMARK(BM_TraverseFlatAst)->RangeMultiplier(10)->Range(100, 10000);
+}
@@ -0,0 +1,103 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "DiceCalculator/Evaluation/RollAstVisitor.h"
+#include "DiceCalculator/Expressions/ConstantNode.h"
+#include "DiceCalculator/Expressions/DiceNode.h"
+#include "DiceCalculator/Expressions/OperatorNode.h"
+#include "DiceCalculator/Operators/Addition.h"
+#include "DiceCalculator/Operators/Subtraction.h"
+#include "DiceCalculator/Xoshiro256Random.h"
+
+namespace DiceCalculator::Operators
+{
+	namespace
+	{
+		using Expressions::DiceAst;
+		using Expressions::OperatorNode;
+
+		// A left-deep chain of `depth` binary additions and subtractions over 1d6 and constant leaves,
+		// the shape of an unflattened long expression: every operator node has exactly two operands.
+		std::shared_ptr<DiceAst> CreateChain(std::size_t depth)
+		{
+			std::shared_ptr<DiceAst> node = std::make_shared<Expressions::DiceNode>(1, 6);
+			for (std::size_t i = 0; i < depth; ++i)
+			{
+				std::shared_ptr<DiceAst> leaf = i % 2 == 0
+					? std::shared_ptr<DiceAst>(std::make_shared<Expressions::ConstantNode>(static_cast<int>(i)))
+					: std::shared_ptr<DiceAst>(std::make_shared<Expressions::DiceNode>(1, 6));
+				std::shared_ptr<DiceOperator> op = i % 3 == 0
+					? std::shared_ptr<DiceOperator>(std::make_shared<Subtraction>())
+					: std::shared_ptr<DiceOperator>(std::make_shared<Addition>());
+				node = std::make_shared<OperatorNode>(op, std::vector<std::shared_ptr<DiceAst>>{ node, leaf });
+			}
+			return node;
+		}
+
+		// Counts the operator nodes below `node`, handing each node's operands over the way the operator
+		// interface used to (a copied vector) or does now (a view).
+		template<typename PassOperands>
+		std::size_t Walk(const DiceAst& node, PassOperands pass)
+		{
+			const auto* operatorNode = dynamic_cast<const OperatorNode*>(&node);
+			if (!operatorNode)
+			{
+				return 0;
+			}
+			return pass(operatorNode->GetOperands(), [&](const DiceAst& operand) { return Walk(operand, pass); });
+		}
+
+		void BM_OperandsByValue(benchmark::State& state)
+		{
+			const auto chain = CreateChain(static_cast<std::size_t>(state.range(0)));
+			const auto pass = [](std::vector<std::shared_ptr<DiceAst>> operands, const auto& walk)
+				{
+					benchmark::DoNotOptimize(operands.data());
+					return 1 + walk(*operands[0]);
+				};
+
+			for (auto _ : state)
+			{
+				benchmark::DoNotOptimize(Walk(*chain, pass));
+			}
+			state.SetItemsProcessed(state.iterations() * state.range(0));
+		}
+
+		void BM_OperandsByView(benchmark::State& state)
+		{
+			const auto chain = CreateChain(static_cast<std::size_t>(state.range(0)));
+			const auto pass = [](Operands operands, const auto& walk)
+				{
+					benchmark::DoNotOptimize(operands.data());
+					return 1 + walk(*operands[0]);
+				};
+
+			for (auto _ : state)
+			{
+				benchmark::DoNotOptimize(Walk(*chain, pass));
+			}
+			state.SetItemsProcessed(state.iterations() * state.range(0));
+		}
+
+		// A whole totals-only roll of the chain; items are operator nodes, so the rate is nodes per second.
+		void BM_RollChain(benchmark::State& state)
+		{
+			const auto chain = CreateChain(static_cast<std::size_t>(state.range(0)));
+			Xoshiro256Random random(42);
+			Evaluation::RollAstVisitor visitor(random, Evaluation::RollAstVisitor::Tracking::TotalsOnly);
+
+			for (auto _ : state)
+			{
+				chain->Accept(visitor);
+				benchmark::DoNotOptimize(visitor.GetResult());
+			}
+			state.SetItemsProcessed(state.iterations() * state.range(0));
+		}
+	}
+
+	BENCHMARK(BM_OperandsByValue)->RangeMultiplier(8)->Range(8, 512);
+	BENCHMARK(BM_OperandsByView)->RangeMultiplier(8)->Range(8, 512);
+	BENCHMARK(BM_RollChain)->RangeMultiplier(8)->Range(8, 512);
+}
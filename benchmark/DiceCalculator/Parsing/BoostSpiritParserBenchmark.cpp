@@ -0,0 +1,47 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "DiceCalculator/Parsing/BoostSpiritParser.h"
+#include "DiceCalculator/Operators/Registry.h"
+
+namespace DiceCalculator::Parsing
+{
+	namespace
+	{
+		const std::string ShortExpression = "1d20 + 5";
+		const std::string LongExpression = "(1d8 + (ADV(2d4) - AttackRoll(1d20, 13))) >= DIS(2d6) + 3";
+
+		// One parser, reused: the grammar is built once. Items are expressions, so the reported rate
+		// is expressions per second.
+		void BM_Parse(benchmark::State& state, const std::string& input)
+		{
+			const BoostSpiritParser parser(std::make_shared<Operators::Registry>());
+
+			for (auto _ : state)
+			{
+				benchmark::DoNotOptimize(parser.Parse(input));
+			}
+			state.SetItemsProcessed(state.iterations());
+		}
+
+		// A fresh parser per expression, which builds the grammar every time, as Parse used to.
+		void BM_ParseWithFreshGrammar(benchmark::State& state, const std::string& input)
+		{
+			const auto registry = std::make_shared<Operators::Registry>();
+
+			for (auto _ : state)
+			{
+				const BoostSpiritParser parser(registry);
+				benchmark::DoNotOptimize(parser.Parse(input));
+			}
+			state.SetItemsProcessed(state.iterations());
+		}
+	}
+
+	BENCHMARK_CAPTURE(BM_Parse, Short, ShortExpression);
+	BENCHMARK_CAPTURE(BM_Parse, Long, LongExpression);
+	BENCHMARK_CAPTURE(BM_ParseWithFreshGrammar, Short, ShortExpression);
+	BENCHMARK_CAPTURE(BM_ParseWithFreshGrammar, Long, LongExpression);
+}
@@ -0,0 +1,92 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "DiceCalculator/IRandom.h"
+#include "DiceCalculator/PhiloxRandom.h"
+#include "DiceCalculator/StdRandom.h"
+#include "DiceCalculator/Xoshiro128x8Random.h"
+#include "DiceCalculator/Xoshiro256Random.h"
+
+namespace DiceCalculator
+{
+	namespace
+	{
+		using RandomFactory = std::unique_ptr<IRandom>(*)();
+
+		std::unique_ptr<IRandom> CreateStdRandom() { return std::make_unique<StdRandom>(); }
+		std::unique_ptr<IRandom> CreatePhiloxRandom() { return std::make_unique<PhiloxRandom>(42); }
+		std::unique_ptr<IRandom> CreateXoshiro256Random() { return std::make_unique<Xoshiro256Random>(42); }
+		std::unique_ptr<IRandom> CreateXoshiro128x8Scalar() { return std::make_unique<Xoshiro128x8Random>(42, 0, Xoshiro128x8Random::InstructionSet::Scalar); }
+		std::unique_ptr<IRandom> CreateXoshiro128x8Best() { return std::make_unique<Xoshiro128x8Random>(42); }
+
+		// Draws state.range(0) d6 faces with one virtual NextInt call each.
+		void BM_NextInt(benchmark::State& state, RandomFactory createRandom)
+		{
+			const std::unique_ptr<IRandom> random = createRandom();
+			IRandom& generator = *random;
+			const std::size_t count = static_cast<std::size_t>(state.range(0));
+			std::vector<int> faces(count);
+
+			for (auto _ : state)
+			{
+				for (int& face : faces)
+				{
+					face = generator.NextInt(1, 6);
+				}
+				benchmark::DoNotOptimize(faces.data());
+				benchmark::ClobberMemory();
+			}
+			state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(count));
+		}
+
+		// Draws the same faces with a single virtual Fill call.
+		void BM_Fill(benchmark::State& state, RandomFactory createRandom)
+		{
+			const std::unique_ptr<IRandom> random = createRandom();
+			IRandom& generator = *random;
+			const std::size_t count = static_cast<std::size_t>(state.range(0));
+			std::vector<int> faces(count);
+
+			for (auto _ : state)
+			{
+				generator.Fill(faces, 1, 6);
+				benchmark::DoNotOptimize(faces.data());
+				benchmark::ClobberMemory();
+			}
+			state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(count));
+		}
+
+
+		// Sums 10d6 for each of state.range(0) samples, as the batch visitor does for a dice node.
+		void BM_SumDice(benchmark::State& state, RandomFactory createRandom)
+		{
+			const std::unique_ptr<IRandom> random = createRandom();
+			const std::size_t count = static_cast<std::size_t>(state.range(0));
+			std::vector<int> sums(count);
+
+			for (auto _ : state)
+			{
+				random->SumDice(sums, {}, 10, 6);
+				benchmark::DoNotOptimize(sums.data());
+				benchmark::ClobberMemory();
+			}
+			state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(count * 10));
+		}
+	}
+
+	BENCHMARK_CAPTURE(BM_NextInt, StdRandom, CreateStdRandom)->RangeMultiplier(16)->Range(16, 4096);
+	BENCHMARK_CAPTURE(BM_Fill, StdRandom, CreateStdRandom)->RangeMultiplier(16)->Range(16, 4096);
+	BENCHMARK_CAPTURE(BM_NextInt, PhiloxRandom, CreatePhiloxRandom)->RangeMultiplier(16)->Range(16, 4096);
+	BENCHMARK_CAPTURE(BM_Fill, PhiloxRandom, CreatePhiloxRandom)->RangeMultiplier(16)->Range(16, 4096);
+	BENCHMARK_CAPTURE(BM_NextInt, Xoshiro256Random, CreateXoshiro256Random)->RangeMultiplier(16)->Range(16, 4096);
+	BENCHMARK_CAPTURE(BM_Fill, Xoshiro256Random, CreateXoshiro256Random)->RangeMultiplier(16)->Range(16, 4096);
+	BENCHMARK_CAPTURE(BM_NextInt, Xoshiro128x8Best, CreateXoshiro128x8Best)->RangeMultiplier(16)->Range(16, 4096);
+	BENCHMARK_CAPTURE(BM_Fill, Xoshiro128x8Scalar, CreateXoshiro128x8Scalar)->RangeMultiplier(16)->Range(16, 4096);
+	BENCHMARK_CAPTURE(BM_Fill, Xoshiro128x8Best, CreateXoshiro128x8Best)->RangeMultiplier(16)->Range(16, 4096);
+	BENCHMARK_CAPTURE(BM_SumDice, StdRandom, CreateStdRandom)->Arg(4096);
+	BENCHMARK_CAPTURE(BM_SumDice, Xoshiro256Random, CreateXoshiro256Random)->Arg(4096);
+	BENCHMARK_CAPTURE(BM_SumDice, Xoshiro128x8Scalar, CreateXoshiro128x8Scalar)->Arg(4096);
+	BENCHMARK_CAPTURE(BM_SumDice, Xoshiro128x8Best, CreateXoshiro128x8Best)->Arg(4096);
+}
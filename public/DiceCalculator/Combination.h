@@ -2,6 +2,11 @@
 
 #include <vector>
 #include <initializer_list>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <span>
 
 namespace DiceCalculator
 {
@@ -15,7 +20,127 @@ namespace DiceCalculator
 			int Value = 0;
 		};
 
+		// Shape of a roll list: the groups of dice it holds, in roll order. All combinations of a stream
+		// share one shape, so a layout is built once per shape and every combination only stores an index
+		// into it. Layouts are interned, so equal shapes share one object that lives for the rest of the
+		// process; an expression has few distinct shapes, which keeps the table small.
+		class RollLayout
+		{
+		public:
+			struct Group
+			{
+				int Rolls = 0;
+				int Sides = 0;
+				// Sorted groups hold one multiset of faces as a non-decreasing sequence, ranked in
+				// lexicographic order; other groups hold every face sequence in odometer order.
+				bool Sorted = false;
+
+				auto operator<=>(const Group&) const = default;
+			};
+
+			// The layout of `groups`; groups without dice are dropped. Throws std::runtime_error when the
+			// layout has more than 2^64 distinct roll lists, which could never be enumerated anyway.
+			static const RollLayout& Get(std::vector<Group> groups);
+
+			// The groups of every layout in `layouts`, in order. Null entries stand for empty layouts.
+			static const RollLayout& Concatenate(std::span<const RollLayout* const> layouts);
+
+			const std::vector<Group>& GetGroups() const { return m_Groups; }
+			std::size_t GetRollCount() const { return m_RollCount; }
+
+			// Number of distinct roll lists, i.e. the exclusive upper bound of their indices.
+			std::uint64_t GetCount() const { return m_Count; }
+
+			// Roll at `position` of the roll list with index `index`.
+			Roll Decode(std::uint64_t index, std::size_t position) const;
+
+			// Index of the roll list holding `rolls`; throws std::out_of_range if they do not fit the layout.
+			std::uint64_t Encode(std::span<const Roll> rolls) const;
+
+		private:
+			explicit RollLayout(std::vector<Group> groups);
+
+			std::vector<Group> m_Groups;
+			// Per group: its number of distinct face lists, its weight in the index and its first roll.
+			std::vector<std::uint64_t> m_GroupCounts;
+			std::vector<std::uint64_t> m_GroupStrides;
+			std::vector<std::size_t> m_GroupStarts;
+			std::size_t m_RollCount = 0;
+			std::uint64_t m_Count = 1;
+		};
+
+		// Rolls of a combination as a mixed-radix index into its layout, 16 bytes whatever the number of
+		// dice. Rolls are decoded on access, so readers see plain Roll values.
+		class RollList
+		{
+		public:
+			// Read-only iterator; rolls are decoded on access, so it yields Roll by value.
+			class const_iterator
+			{
+			public:
+				using iterator_category = std::input_iterator_tag;
+				using value_type = Roll;
+				using difference_type = std::ptrdiff_t;
+				using reference = value_type;
+				using pointer = void;
+
+				const_iterator() = default;
+
+				value_type operator*() const { return (*m_List)[m_Position]; }
+
+				const_iterator& operator++()
+				{
+					++m_Position;
+					return *this;
+				}
+
+				const_iterator operator++(int)
+				{
+					const_iterator copy = *this;
+					++m_Position;
+					return copy;
+				}
+
+				bool operator==(const const_iterator& other) const = default;
+
+			private:
+				friend class RollList;
+				const_iterator(const RollList* list, std::size_t position) : m_List(list), m_Position(position) {}
+
+				const RollList* m_List = nullptr;
+				std::size_t m_Position = 0;
+			};
+
+			RollList() = default;
+			RollList(const RollLayout& layout, std::uint64_t index) : m_Layout(&layout), m_Index(index) {}
+
+			// Builds a list of single-die groups. Throws std::out_of_range for faces outside [1, Sides].
+			RollList(std::initializer_list<Roll> rolls);
+
+			std::size_t size() const { return m_Layout ? m_Layout->GetRollCount() : 0; }
+			bool empty() const { return size() == 0; }
+
+			Roll operator[](std::size_t index) const { return m_Layout->Decode(m_Index, index); }
+
+			const_iterator begin() const { return const_iterator(this, 0); }
+			const_iterator end() const { return const_iterator(this, size()); }
+
+			// Position of the first roll with `sides` sides, or size() if there is none.
+			std::size_t FindSides(int sides) const;
+
+			// Null for an empty list.
+			const RollLayout* GetLayout() const { return m_Layout; }
+			std::uint64_t GetIndex() const { return m_Index; }
+
+		private:
+			const RollLayout* m_Layout = nullptr;
+			std::uint64_t m_Index = 0;
+		};
+
 		int TotalValue = 0;
-		std::vector<Roll> Rolls = {};
+		RollList Rolls = {};
+		// Number of equally likely roll sequences this combination stands for. It is 1 unless dice are
+		// enumerated as multisets, where one sorted roll list represents all of its orderings.
+		double Weight = 1.0;
 	};
-}
\ No newline at end of file
+}
@@ -3,14 +3,110 @@
 #include <vector>
 #include <utility>
 #include <algorithm>
+#include <iterator>
+#include <cstddef>
+#include <limits>
 #include <initializer_list>
 #include "DiceCalculator/Combination.h"
+#include "DiceCalculator/Evaluation/CombinationStream.h"
 
 namespace DiceCalculator
 {
+	// Probability distribution over integer outcomes.
+	//
+	// Outcomes are stored densely (value of the first slot + contiguous probabilities) whenever the
+	// support is compact, which is what every dice sum produces. Genuinely sparse supports fall back
+	// to a sorted flat map of (value, probability) pairs. In both representations a probability of
+	// 0.0 means "no such outcome": such entries are skipped by iteration and not counted by Size().
 	class Distribution
 	{
 	public:
+		// Spans up to this many slots are always stored densely.
+		constexpr static std::size_t DenseMinimumSpan = 64;
+		// Larger spans stay dense while span <= outcomes * SparseFillRatio.
+		constexpr static std::size_t SparseFillRatio = 8;
+
+		// Read-only iterator over non-zero (value, probability) pairs in ascending value order.
+		class const_iterator
+		{
+		public:
+			using iterator_concept = std::bidirectional_iterator_tag;
+			using iterator_category = std::input_iterator_tag;
+			using value_type = std::pair<int, double>;
+			using difference_type = std::ptrdiff_t;
+			using reference = value_type;
+			using pointer = void;
+
+			const_iterator() = default;
+
+			value_type operator*() const
+			{
+				if (m_Owner->m_IsDense)
+				{
+					return { m_Owner->m_Offset + static_cast<int>(m_Index), m_Owner->m_Dense[m_Index] };
+				}
+				return m_Owner->m_Sparse[m_Index];
+			}
+
+			const_iterator& operator++()
+			{
+				++m_Index;
+				SkipZeros();
+				return *this;
+			}
+
+			const_iterator operator++(int)
+			{
+				const_iterator copy = *this;
+				++*this;
+				return copy;
+			}
+
+			const_iterator& operator--()
+			{
+				do
+				{
+					--m_Index;
+				} while (m_Owner->SlotProbability(m_Index) == 0.0);
+				return *this;
+			}
+
+			const_iterator operator--(int)
+			{
+				const_iterator copy = *this;
+				--*this;
+				return copy;
+			}
+
+			bool operator==(const const_iterator& other) const noexcept
+			{
+				return m_Index == other.m_Index;
+			}
+
+		private:
+			friend class Distribution;
+
+			const_iterator(const Distribution* owner, std::size_t index) : m_Owner(owner), m_Index(index)
+			{
+				SkipZeros();
+			}
+
+			void SkipZeros()
+			{
+				const std::size_t count = m_Owner->SlotCount();
+				while (m_Index < count && m_Owner->SlotProbability(m_Index) == 0.0)
+				{
+					++m_Index;
+				}
+			}
+
+			const Distribution* m_Owner = nullptr;
+			std::size_t m_Index = 0;
+		};
+
+		using iterator = const_iterator;
+		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
 		Distribution() = default;
 
 		Distribution(std::initializer_list<std::pair<int, double>> init)
@@ -24,100 +120,186 @@ namespace DiceCalculator
 			return *this;
 		}
 
-		using iterator = std::vector<std::pair<int, double>>::iterator;
-		using const_iterator = std::vector<std::pair<int, double>>::const_iterator;
+		// Build a distribution from contiguous probabilities, where probabilities[i] is P(offset + i).
+		// Zero slots at either end are trimmed; very sparse inputs are converted to the flat map.
+		static Distribution FromDense(int offset, std::vector<double> probabilities)
+		{
+			Distribution d;
+			d.m_Offset = offset;
+			d.m_Dense = std::move(probabilities);
+			d.Rebalance();
+			return d;
+		}
+
+		// Build a distribution from arbitrary (value, probability) pairs. Duplicates are accumulated.
+		static Distribution FromOutcomes(const std::vector<std::pair<int, double>>& outcomes)
+		{
+			Distribution d;
+			d.AssignFrom(outcomes);
+			return d;
+		}
 
-		// Insert or accumulate probability for `value`. Keeps entries sorted by value.
+		// Insert or accumulate probability for `value`.
 		void AddOutcome(int value, double probability)
 		{
 			if (probability == 0.0)
 				return;
 
-			auto it = std::lower_bound(m_Data.begin(), m_Data.end(), value,
+			if (m_IsDense && EnsureDenseSlot(value))
+			{
+				m_Dense[static_cast<std::size_t>(value - m_Offset)] += probability;
+				return;
+			}
+
+			auto it = std::lower_bound(m_Sparse.begin(), m_Sparse.end(), value,
 				[](auto const& lhs, int v) { return lhs.first < v; });
 
-			if (it != m_Data.end() && it->first == value)
+			if (it != m_Sparse.end() && it->first == value)
 			{
 				it->second += probability;
 				if (it->second == 0.0)
-					m_Data.erase(it);
+					m_Sparse.erase(it);
 			}
 			else
 			{
-				m_Data.insert(it, std::pair<int, double>(value, probability));
+				m_Sparse.insert(it, std::pair<int, double>(value, probability));
 			}
 		}
 
-		// Mutable operator[]: ensures an entry exists and returns a reference to its probability.
-		// Inserts with probability 0.0 if the key is missing.
+		// Mutable operator[]: ensures a slot exists and returns a reference to its probability.
+		// The slot starts at 0.0 if the key is missing.
 		double& operator[](int value)
 		{
-			auto it = std::lower_bound(m_Data.begin(), m_Data.end(), value,
+			if (m_IsDense && EnsureDenseSlot(value))
+				return m_Dense[static_cast<std::size_t>(value - m_Offset)];
+
+			auto it = std::lower_bound(m_Sparse.begin(), m_Sparse.end(), value,
 				[](auto const& lhs, int v) { return lhs.first < v; });
 
-			if (it != m_Data.end() && it->first == value)
+			if (it != m_Sparse.end() && it->first == value)
 				return it->second;
 
-			it = m_Data.insert(it, std::pair<int, double>(value, 0.0));
+			it = m_Sparse.insert(it, std::pair<int, double>(value, 0.0));
 			return it->second;
 		}
 
 		// Const operator[]: returns the probability for `value` or 0.0 if missing.
 		double operator[](int value) const noexcept
 		{
-			auto it = std::lower_bound(m_Data.begin(), m_Data.end(), value,
+			if (m_IsDense)
+			{
+				const long long index = static_cast<long long>(value) - m_Offset;
+				if (index < 0 || index >= static_cast<long long>(m_Dense.size()))
+					return 0.0;
+				return m_Dense[static_cast<std::size_t>(index)];
+			}
+
+			auto it = std::lower_bound(m_Sparse.begin(), m_Sparse.end(), value,
 				[](auto const& lhs, int v) { return lhs.first < v; });
 
-			if (it != m_Data.end() && it->first == value)
+			if (it != m_Sparse.end() && it->first == value)
 				return it->second;
 			return 0.0;
 		}
 
-		// Iteration support (flat-map iteration over pairs)
-		iterator begin() noexcept { return m_Data.begin(); }
-		iterator end() noexcept { return m_Data.end(); }
-		const_iterator begin() const noexcept { return m_Data.begin(); }
-		const_iterator end() const noexcept { return m_Data.end(); }
-		const_iterator cbegin() const noexcept { return m_Data.cbegin(); }
-		const_iterator cend() const noexcept { return m_Data.cend(); }
+		const_iterator begin() const noexcept { return const_iterator(this, 0); }
+		const_iterator end() const noexcept { return const_iterator(this, SlotCount()); }
+		const_iterator cbegin() const noexcept { return begin(); }
+		const_iterator cend() const noexcept { return end(); }
+		const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+		const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
 
-		// Read-only access to the flat-map data (sorted unique keys).
-		const std::vector<std::pair<int, double>>& GetData() const noexcept
+		// Snapshot of the non-zero outcomes as sorted (value, probability) pairs.
+		std::vector<std::pair<int, double>> GetData() const
 		{
-			return m_Data;
+			return std::vector<std::pair<int, double>>(begin(), end());
 		}
 
-		// Mutable access when callers need to modify directly.
-		std::vector<std::pair<int, double>>& GetData() noexcept
-		{
-			return m_Data;
-		}
+		bool IsDense() const noexcept { return m_IsDense; }
+
+		// Value of the first dense slot. Only meaningful when IsDense().
+		int GetOffset() const noexcept { return m_Offset; }
+
+		// Dense slots, where slot i holds P(GetOffset() + i). Empty for sparse distributions.
+		const std::vector<double>& GetProbabilities() const noexcept { return m_Dense; }
 
 		// Normalize probabilities so they sum to 1. No-op when sum is 0.
 		void Normalize()
 		{
 			double sum = 0.0;
-			for (auto const& p : m_Data) sum += p.second;
+			for (auto const& [value, probability] : *this) sum += probability;
 			if (sum == 0.0) return;
-			for (auto &p : m_Data) p.second /= sum;
+			for (auto& p : m_Dense) p /= sum;
+			for (auto& p : m_Sparse) p.second /= sum;
+			Rebalance();
 		}
 
-		void Clear() noexcept { m_Data.clear(); }
-		size_t Size() const noexcept { return m_Data.size(); }
-		void Reserve(size_t n) { m_Data.reserve(n); }
+		// Distribution of -X.
+		Distribution Negated() const
+		{
+			Distribution d;
+			d.m_IsDense = m_IsDense;
+			if (m_IsDense)
+			{
+				d.m_Dense.assign(m_Dense.rbegin(), m_Dense.rend());
+				d.m_Offset = -(m_Offset + static_cast<int>(m_Dense.size()) - 1);
+			}
+			else
+			{
+				d.m_Sparse.reserve(m_Sparse.size());
+				for (auto it = m_Sparse.rbegin(); it != m_Sparse.rend(); ++it)
+				{
+					d.m_Sparse.emplace_back(-it->first, it->second);
+				}
+			}
+			return d;
+		}
+
+		// Turns X into X + delta. Dense distributions only move their offset.
+		void Shift(int delta) noexcept
+		{
+			if (m_IsDense)
+			{
+				m_Offset += delta;
+				return;
+			}
+			for (auto& [value, probability] : m_Sparse)
+			{
+				value += delta;
+			}
+		}
+
+		void Clear() noexcept
+		{
+			m_Dense.clear();
+			m_Sparse.clear();
+			m_Offset = 0;
+			m_IsDense = true;
+		}
+
+		bool IsEmpty() const noexcept { return begin() == end(); }
+		size_t Size() const noexcept { return static_cast<size_t>(std::distance(begin(), end())); }
+
+		void Reserve(size_t n)
+		{
+			if (m_IsDense)
+				m_Dense.reserve(n);
+			else
+				m_Sparse.reserve(n);
+		}
 
 		std::pair<int, int> GetMinMax() const noexcept
 		{
-			if (m_Data.empty())
+			if (IsEmpty())
 			{
 				return {0, 0};
 			}
 
-			return std::make_pair(m_Data.front().first, m_Data.back().first);
+			return std::make_pair((*begin()).first, (*rbegin()).first);
 		}
 
-		// Create a normalized distribution from a list of combinations,
-		// assuming each combination is equally likely.
+		// Create a normalized distribution from a list of combinations, each counted Weight times
+		// (once, unless dice were enumerated as multisets).
 		static Distribution FromCombinations(const std::vector<Combination>& combinations)
 		{
 			Distribution d;
@@ -127,20 +309,144 @@ namespace DiceCalculator
 			for (const auto& c : combinations)
 			{
 				// Count occurrences of each total value; normalization will convert counts to probabilities.
-				d.AddOutcome(c.TotalValue, 1.0);
+				d.AddOutcome(c.TotalValue, c.Weight);
+			}
+			d.Normalize();
+			return d;
+		}
+
+		// Same as above, but pulls the combinations one at a time from the start of `stream`, so only the
+		// counts per total are held in memory.
+		static Distribution FromCombinations(Evaluation::CombinationStream& stream)
+		{
+			Distribution d;
+			stream.Reset();
+			Combination c;
+			while (stream.Next(c))
+			{
+				d.AddOutcome(c.TotalValue, c.Weight);
 			}
 			d.Normalize();
 			return d;
 		}
 
 	private:
-		// Sorted vector of (value, probability) acting as a flat map.
-		std::vector<std::pair<int, double>> m_Data;
+		bool m_IsDense = true;
+
+		// Dense representation: m_Dense[i] is the probability of m_Offset + i.
+		int m_Offset = 0;
+		std::vector<double> m_Dense;
+
+		// Sparse representation: sorted vector of (value, probability) acting as a flat map.
+		std::vector<std::pair<int, double>> m_Sparse;
+
+		std::size_t SlotCount() const noexcept
+		{
+			return m_IsDense ? m_Dense.size() : m_Sparse.size();
+		}
+
+		double SlotProbability(std::size_t index) const noexcept
+		{
+			return m_IsDense ? m_Dense[index] : m_Sparse[index].second;
+		}
+
+		static bool ShouldBeDense(std::size_t span, std::size_t outcomes) noexcept
+		{
+			return span <= DenseMinimumSpan || span / SparseFillRatio <= outcomes;
+		}
+
+		// Makes sure the dense storage covers `value`. Switches to the sparse representation and
+		// returns false when covering it would leave the storage mostly empty.
+		bool EnsureDenseSlot(int value)
+		{
+			if (m_Dense.empty())
+			{
+				m_Offset = value;
+				m_Dense.push_back(0.0);
+				return true;
+			}
+
+			const long long first = m_Offset;
+			const long long last = first + static_cast<long long>(m_Dense.size()) - 1;
+			if (value >= first && value <= last)
+				return true;
+
+			const long long span = std::max<long long>(last, value) - std::min<long long>(first, value) + 1;
+			if (static_cast<std::size_t>(span) > std::max(DenseMinimumSpan, 2 * m_Dense.size()))
+			{
+				ConvertToSparse();
+				return false;
+			}
+
+			if (value > last)
+			{
+				m_Dense.resize(static_cast<std::size_t>(value - first + 1), 0.0);
+			}
+			else
+			{
+				// Leave headroom in front so that descending insertions stay amortized O(1).
+				const long long headroom = std::min<long long>(
+					static_cast<long long>(m_Dense.size()),
+					static_cast<long long>(value) - std::numeric_limits<int>::min());
+				const long long grow = first - value + headroom;
+				m_Dense.insert(m_Dense.begin(), static_cast<std::size_t>(grow), 0.0);
+				m_Offset = static_cast<int>(value - headroom);
+			}
+			return true;
+		}
+
+		void ConvertToSparse()
+		{
+			m_Sparse = GetData();
+			m_Dense.clear();
+			m_Offset = 0;
+			m_IsDense = false;
+		}
+
+		// Picks the representation matching the current support and trims empty dense edges.
+		void Rebalance()
+		{
+			std::size_t outcomes = Size();
+			if (outcomes == 0)
+			{
+				Clear();
+				return;
+			}
+
+			auto [minValue, maxValue] = GetMinMax();
+			const std::size_t span = static_cast<std::size_t>(static_cast<long long>(maxValue) - minValue + 1);
+			if (!ShouldBeDense(span, outcomes))
+			{
+				if (m_IsDense)
+					ConvertToSparse();
+				return;
+			}
+
+			if (m_IsDense)
+			{
+				const std::size_t leading = static_cast<std::size_t>(static_cast<long long>(minValue) - m_Offset);
+				m_Dense.resize(leading + span);
+				m_Dense.erase(m_Dense.begin(), m_Dense.begin() + static_cast<std::ptrdiff_t>(leading));
+			}
+			else
+			{
+				std::vector<double> dense(span, 0.0);
+				for (auto const& [value, probability] : m_Sparse)
+				{
+					dense[static_cast<std::size_t>(static_cast<long long>(value) - minValue)] = probability;
+				}
+				m_Dense = std::move(dense);
+				m_Sparse.clear();
+				m_IsDense = true;
+			}
+			m_Offset = minValue;
+		}
 
 		template<typename Range>
 		void AssignFrom(Range const& r)
 		{
-			m_Data.clear();
+			Clear();
+			m_IsDense = false;
 			// Copy into temporary to allow sorting/merging
 			std::vector<std::pair<int, double>> tmp;
 			tmp.reserve(std::distance(std::begin(r), std::end(r)));
@@ -148,8 +454,6 @@ namespace DiceCalculator
 			{
 				tmp.emplace_back(p.first, p.second);
 			}
-			if (tmp.empty())
-				return;
 
 			std::sort(tmp.begin(), tmp.end(),
 				[](auto const& a, auto const& b) { return a.first < b.first; });
@@ -159,17 +463,19 @@ namespace DiceCalculator
 			{
 				if (p.second == 0.0)
 					continue;
-				if (!m_Data.empty() && m_Data.back().first == p.first)
+				if (!m_Sparse.empty() && m_Sparse.back().first == p.first)
 				{
-					m_Data.back().second += p.second;
-					if (m_Data.back().second == 0.0)
-						m_Data.pop_back();
+					m_Sparse.back().second += p.second;
+					if (m_Sparse.back().second == 0.0)
+						m_Sparse.pop_back();
 				}
 				else
 				{
-					m_Data.emplace_back(p);
+					m_Sparse.emplace_back(p);
 				}
 			}
+
+			Rebalance();
 		}
 	};
 }
\ No newline at end of file
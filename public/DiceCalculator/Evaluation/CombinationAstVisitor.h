@@ -1,25 +1,72 @@
 #pragma once
 
+#include <cstdint>
+#include <memory>
 #include "DiceCalculator/Evaluation/DiceAstVisitor.h"
+#include "DiceCalculator/Evaluation/CombinationStream.h"
 #include "DiceCalculator/Distribution.h"
 #include "DiceCalculator/Combination.h"
+#include "DiceCalculator/ThreadPool.h"
 
 namespace DiceCalculator::Evaluation
 {
+	// Builds a CombinationStream for the visited expression. Nothing is enumerated until the stream is
+	// pulled, so expressions with any number of outcomes can be folded with Distribution::FromCombinations.
 	class CombinationAstVisitor : public Evaluation::DiceAstVisitor
 	{
 	public:
 
+		// Upper bound for GetCombinations, which materializes every outcome.
 		constexpr static int MaxCombinationsThreshold = 10000000;
 
+		// Default upper bound for GetDistribution, which streams every outcome. At some ten million
+		// combinations per second and core, this keeps a fold to seconds rather than hours.
+		constexpr static std::uint64_t DefaultMaxStreamedCombinations = 100000000;
+
+		// How dice nodes are enumerated.
+		enum class Counting
+		{
+			// Every ordered roll sequence, each with weight 1.
+			Sequences,
+			// Every multiset of faces once, sorted and weighted by its number of orderings. Totals and
+			// the resulting distribution are unchanged, but roll lists no longer show every ordering.
+			Multisets
+		};
+
+		// Streams are split into this many shards per pool thread, so that work stealing can even out
+		// shards of different sizes.
+		constexpr static std::size_t ShardsPerThread = 4;
+
+		// With a thread pool, GetDistribution folds shards of the stream concurrently.
+		explicit CombinationAstVisitor(Counting counting = Counting::Sequences, std::shared_ptr<ThreadPool> threadPool = nullptr,
+			std::uint64_t maxStreamedCombinations = DefaultMaxStreamedCombinations)
+			: m_Counting(counting), m_ThreadPool(std::move(threadPool)), m_MaxStreamedCombinations(maxStreamedCombinations) {}
+
 		void Visit(const DiceCalculator::Expressions::ConstantNode& node) override;
 		void Visit(const DiceCalculator::Expressions::DiceNode& node) override;
 		void Visit(const DiceCalculator::Expressions::OperatorNode& node) override;
 
-		// const DiceCalculator::Distribution& GetDistribution() const { return m_Distribution; }
-		const std::vector<Combination>& GetCombinations() const { return m_Combinations; }
+		// Hands over the stream built by the last Accept; operators use this to compose their operands.
+		std::unique_ptr<CombinationStream> TakeStream();
+
+		// Enumerates the stream built by the last Accept into a vector, from the first combination.
+		// Throws when there are more than MaxCombinationsThreshold combinations.
+		std::vector<Combination> GetCombinations();
+
+		// Folds the stream built by the last Accept into a normalized distribution. With a thread pool the
+		// stream is partitioned, every shard is counted into its own distribution and the shards are
+		// merged in order, so the result does not depend on thread timing. Throws std::runtime_error
+		// without enumerating anything when the stream has more than GetMaxStreamedCombinations().
+		DiceCalculator::Distribution GetDistribution() const;
+
+		Counting GetCounting() const { return m_Counting; }
+		const std::shared_ptr<ThreadPool>& GetThreadPool() const { return m_ThreadPool; }
+		std::uint64_t GetMaxStreamedCombinations() const { return m_MaxStreamedCombinations; }
 
 	private:
-		std::vector<Combination> m_Combinations;
+		Counting m_Counting;
+		std::shared_ptr<ThreadPool> m_ThreadPool;
+		std::uint64_t m_MaxStreamedCombinations;
+		std::unique_ptr<CombinationStream> m_Stream;
 	};
-}
\ No newline at end of file
+}
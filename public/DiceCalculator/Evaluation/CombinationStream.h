@@ -0,0 +1,159 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "DiceCalculator/Combination.h"
+
+namespace DiceCalculator::Evaluation
+{
+	// Pull-based enumeration of the equally likely outcomes of an expression. Streams hold only the
+	// state of their current position, so enumerating any number of outcomes takes constant memory.
+	class CombinationStream
+	{
+	public:
+		virtual ~CombinationStream() = default;
+
+		// Writes the next combination into `out` and returns true, or returns false once the stream is
+		// exhausted. `out` is overwritten in place.
+		virtual bool Next(Combination& out) = 0;
+
+		// Rewinds to the first combination.
+		virtual void Reset() = 0;
+
+		// Returns an independent copy of this stream, rewound to the first combination.
+		virtual std::unique_ptr<CombinationStream> Clone() const = 0;
+
+		// Number of combinations the stream yields from the first one, computed without enumerating
+		// them. Saturates at the largest std::uint64_t.
+		virtual std::uint64_t Count() const = 0;
+
+		// Splits the stream into at most `count` independent, rewound streams that together yield every
+		// combination of this one exactly once, though not necessarily in the same order. Streams that
+		// cannot be split return a single clone.
+		virtual std::vector<std::unique_ptr<CombinationStream>> Partition(std::size_t count) const;
+	};
+
+	// Yields a fixed list of combinations; used for constants and for empty results.
+	class ListCombinationStream : public CombinationStream
+	{
+	public:
+		explicit ListCombinationStream(std::vector<Combination> combinations);
+
+		bool Next(Combination& out) override;
+		void Reset() override;
+		std::unique_ptr<CombinationStream> Clone() const override;
+		std::uint64_t Count() const override;
+		std::vector<std::unique_ptr<CombinationStream>> Partition(std::size_t count) const override;
+
+	private:
+		std::vector<Combination> m_Combinations;
+		std::size_t m_Position = 0;
+	};
+
+	// Yields every face sequence of `rolls` dice with `sides` sides, the last die changing fastest. That
+	// is the index order of their roll layout; a partition only yields the indices [firstIndex, endIndex).
+	class DiceCombinationStream : public CombinationStream
+	{
+	public:
+		DiceCombinationStream(int rolls, int sides);
+		DiceCombinationStream(int rolls, int sides, std::uint64_t firstIndex, std::uint64_t endIndex);
+
+		bool Next(Combination& out) override;
+		void Reset() override;
+		std::unique_ptr<CombinationStream> Clone() const override;
+		std::uint64_t Count() const override;
+
+		// Splits the indices into ranges of equal length.
+		std::vector<std::unique_ptr<CombinationStream>> Partition(std::size_t count) const override;
+
+	private:
+		int m_Rolls;
+		int m_Sides;
+		const Combination::RollLayout* m_Layout;
+		std::uint64_t m_FirstIndex;
+		std::uint64_t m_EndIndex;
+		// Index of the next combination; the faces hold the previous one.
+		std::uint64_t m_Index = 0;
+		std::vector<int> m_Faces;
+	};
+
+	// Yields every multiset of faces of `rolls` dice with `sides` sides once, as a non-decreasing roll
+	// list weighted by the number of orderings of that multiset. NdS takes C(N + S - 1, N) steps instead
+	// of S^N, e.g. 3003 instead of about 60 million for 10d6. Multisets come in the index order of their
+	// roll layout; a partition only yields the indices [firstIndex, endIndex).
+	class MultisetDiceCombinationStream : public CombinationStream
+	{
+	public:
+		MultisetDiceCombinationStream(int rolls, int sides);
+		MultisetDiceCombinationStream(int rolls, int sides, std::uint64_t firstIndex, std::uint64_t endIndex);
+
+		bool Next(Combination& out) override;
+		void Reset() override;
+		std::unique_ptr<CombinationStream> Clone() const override;
+		std::uint64_t Count() const override;
+
+		// Splits the indices into ranges of equal length.
+		std::vector<std::unique_ptr<CombinationStream>> Partition(std::size_t count) const override;
+
+	private:
+		int m_Rolls;
+		int m_Sides;
+		const Combination::RollLayout* m_Layout;
+		std::uint64_t m_FirstIndex;
+		std::uint64_t m_EndIndex;
+		// Index of the next combination; the faces hold the previous one.
+		std::uint64_t m_Index = 0;
+		std::vector<int> m_Faces;
+	};
+
+	// Yields one combination per element of the cartesian product of its parts, the last part changing
+	// fastest. Inner parts are rewound rather than buffered, so they are re-enumerated once per
+	// combination of the parts before them.
+	class ProductCombinationStream : public CombinationStream
+	{
+	public:
+		// Builds the output combination from the current combination of every part. The output Weight is
+		// set by the stream afterwards, to the product of the parts' weights.
+		using Combiner = std::function<void(const std::vector<Combination>& parts, Combination& out)>;
+
+		// Where the output Rolls come from.
+		enum class Rolls
+		{
+			// The stream sets them to the rolls of every part, in part order.
+			Concatenated,
+			// The combiner sets them.
+			FromCombiner
+		};
+
+		ProductCombinationStream(std::vector<std::unique_ptr<CombinationStream>> parts, Combiner combiner, Rolls rolls = Rolls::Concatenated);
+
+		bool Next(Combination& out) override;
+		void Reset() override;
+		std::unique_ptr<CombinationStream> Clone() const override;
+		std::uint64_t Count() const override;
+
+		// Splits the first part that can be split. When that yields fewer than `count` shards, every
+		// shard is split further along the parts after it.
+		std::vector<std::unique_ptr<CombinationStream>> Partition(std::size_t count) const override;
+
+	private:
+		std::vector<std::unique_ptr<CombinationStream>> m_Parts;
+		std::vector<Combination> m_Current;
+		Combiner m_Combiner;
+		Rolls m_Rolls;
+		bool m_Started = false;
+		bool m_Exhausted = false;
+
+		// Layouts of the parts the concatenated layout was last built for, and the weight of every
+		// part's index in it. Part layouts rarely change, so the concatenation is built once.
+		std::vector<const Combination::RollLayout*> m_PartLayouts;
+		std::vector<std::uint64_t> m_PartStrides;
+		const Combination::RollLayout* m_Layout = nullptr;
+
+		void ConcatenateRolls(Combination& out);
+		std::vector<std::unique_ptr<CombinationStream>> PartitionFrom(std::size_t firstPart, std::size_t count) const;
+	};
+}
@@ -1,20 +1,64 @@
 #pragma once
 
 #include "DiceCalculator/Evaluation/DiceAstVisitor.h"
+#include "DiceCalculator/Expressions/DiceAst.h"
 #include "DiceCalculator/Distribution.h"
+#include "DiceCalculator/Evaluation/Convolver.h"
+#include "DiceCalculator/Evaluation/DistributionCache.h"
+#include "DiceCalculator/ThreadPool.h"
+#include <memory>
+#include <span>
+#include <vector>
 
 namespace DiceCalculator::Evaluation
 {
 	class ConvolutionAstVisitor : public Evaluation::DiceAstVisitor
 	{
 	public:
+		// With a thread pool, sibling operands of operator nodes are evaluated concurrently. With a cache,
+		// every dice and operator node is looked up before it is evaluated and stored afterwards; a cache
+		// should only be shared between visitors with the same Convolver settings. Independently of the
+		// cache, a subtree that is shared within the evaluated DAG (see Expressions::AstFactory) is
+		// evaluated only once per evaluation.
+		explicit ConvolutionAstVisitor(Convolver convolver = Convolver(), std::shared_ptr<ThreadPool> threadPool = nullptr, std::shared_ptr<DistributionCache> cache = nullptr)
+			: m_Convolver(convolver), m_ThreadPool(std::move(threadPool)), m_Cache(std::move(cache)) {}
+
 		void Visit(const DiceCalculator::Expressions::ConstantNode& node) override;
 		void Visit(const DiceCalculator::Expressions::DiceNode& node) override;
 		void Visit(const DiceCalculator::Expressions::OperatorNode& node) override;
 
 		const DiceCalculator::Distribution& GetDistribution() const { return m_Distribution; }
+		const Convolver& GetConvolver() const { return m_Convolver; }
+		const std::shared_ptr<ThreadPool>& GetThreadPool() const { return m_ThreadPool; }
+		const std::shared_ptr<DistributionCache>& GetCache() const { return m_Cache; }
+
+		// Evaluates every operand into its own distribution, each with a fresh visitor.
+		std::vector<DiceCalculator::Distribution> EvaluateOperands(std::span<const std::shared_ptr<DiceCalculator::Expressions::DiceAst>> operands) const;
+
+		// Distribution of (sum of `positive`) - (sum of `negative`). The terms are combined in Huffman
+		// order, narrowest supports first. The merge tree depends only on the operands, never on thread
+		// timing, so the result is bit-identical with and without a thread pool. Bare dice are folded in
+		// with Convolver::AddDice/SubtractDice, and constants shift the result instead of being convolved.
+		DiceCalculator::Distribution EvaluateSum(
+			std::span<const std::shared_ptr<DiceCalculator::Expressions::DiceAst>> positive,
+			std::span<const std::shared_ptr<DiceCalculator::Expressions::DiceAst>> negative = {}) const;
 
 	private:
 		DiceCalculator::Distribution m_Distribution;
+		Convolver m_Convolver;
+		std::shared_ptr<ThreadPool> m_ThreadPool;
+		std::shared_ptr<DistributionCache> m_Cache;
+
+		// Set for the duration of one top-level Accept and handed down to child visitors.
+		struct EvaluationState;
+		std::shared_ptr<EvaluationState> m_Evaluation;
+
+		ConvolutionAstVisitor CreateChild() const;
+
+		// Produces the distribution of `node` via the per-evaluation memo, the cache and finally `compute`.
+		DiceCalculator::Distribution EvaluateNode(const DiceCalculator::Expressions::DiceAst& node, const std::function<DiceCalculator::Distribution()>& compute);
+
+		// Runs body(0..count-1) on the thread pool if there is one, otherwise in order on this thread.
+		void ForEach(std::size_t count, const std::function<void(std::size_t)>& body) const;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+namespace DiceCalculator::Evaluation
+{
+	// Direct (O(n*m)) convolution kernels for dense probability arrays, one per instruction set.
+	// The best kernel supported by the running CPU is picked once, on first use.
+	class ConvolutionKernels
+	{
+	public:
+		enum class InstructionSet
+		{
+			Scalar,
+			Sse2,
+			Avx2,
+			Avx512
+		};
+
+		// result[i + j] += lhs[i] * rhs[j]; `result` must hold lhsSize + rhsSize - 1 values.
+		using DirectKernel = void (*)(const double* lhs, std::size_t lhsSize, const double* rhs, std::size_t rhsSize, double* result);
+
+		static bool IsSupported(InstructionSet instructionSet);
+		static InstructionSet GetBestSupported();
+		static std::string_view GetName(InstructionSet instructionSet);
+
+		// Returns nullptr if the kernel is not compiled in or not supported by this CPU.
+		static DirectKernel GetDirectKernel(InstructionSet instructionSet);
+
+		// Runs the kernel for GetBestSupported().
+		static void ConvolveDirect(const double* lhs, std::size_t lhsSize, const double* rhs, std::size_t rhsSize, double* result);
+	};
+}
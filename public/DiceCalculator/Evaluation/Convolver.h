@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include "DiceCalculator/Distribution.h"
+
+namespace DiceCalculator::Evaluation
+{
+	// Combines distributions of independent random variables.
+	class Convolver
+	{
+	public:
+		struct Settings
+		{
+			// Dense convolutions switch from the direct O(n*m) kernel to the FFT once both operands
+			// have at least this many slots. With the vectorized direct kernels the crossover sits around
+			// a thousand slots per operand. FFT slots whose value is too small to be told apart from
+			// round-off, such as the far tails of large pools, are summed directly, so the FFT path
+			// keeps the same support and relative tail accuracy as the direct kernel.
+			std::size_t FftThreshold = 1024;
+
+			// NdS pools are generated from exact integer counts as long as the estimated big-integer work
+			// (coefficients times 32-bit limbs) stays below this limit; larger pools use Power instead.
+			std::size_t ExactDiceWorkLimit = std::size_t{ 1 } << 26;
+		};
+
+		Convolver() = default;
+		explicit Convolver(Settings settings) : m_Settings(settings) {}
+
+		// Distribution of X + Y.
+		Distribution Add(const Distribution& lhs, const Distribution& rhs) const;
+
+		// Distribution of X - Y.
+		Distribution Subtract(const Distribution& lhs, const Distribution& rhs) const;
+
+		// Distribution of X1 + ... + Xn for n independent copies of X, using O(log n) convolutions.
+		Distribution Power(const Distribution& base, int exponent) const;
+
+		// Distribution of X + NdS. Uses the sliding-window kernel when that is cheaper than a full convolution.
+		Distribution AddDice(const Distribution& lhs, int rolls, int sides) const;
+
+		// Distribution of X - NdS.
+		Distribution SubtractDice(const Distribution& lhs, int rolls, int sides) const;
+
+		// Distribution of X + U where U is uniform over `faces` consecutive values starting at `lowestFace`.
+		// Runs in O(support + faces) using a sliding window sum.
+		static Distribution AddUniform(const Distribution& lhs, int lowestFace, int faces);
+
+		// Distribution of the sum of `rolls` fair dice with faces 1..`sides`.
+		Distribution UniformDiceSum(int rolls, int sides) const;
+
+		const Settings& GetSettings() const { return m_Settings; }
+
+	private:
+		Settings m_Settings;
+
+		static Distribution ExactUniformDiceSum(int rolls, int sides);
+		bool PrefersSlidingWindow(const Distribution& lhs, int rolls, int sides) const;
+		static Distribution AddMixed(const Distribution& lhs, const Distribution& rhs);
+
+		// result[i] = (values[i - faces + 1] + ... + values[i]) / faces, with out-of-range values treated as zero.
+		static void ConvolveUniform(const double* values, std::size_t size, std::size_t faces, double* result);
+
+		// Result slots near or below the FFT round-off bound are recomputed as direct sums.
+		static void ConvolveFft(const double* lhs, std::size_t lhsSize, const double* rhs, std::size_t rhsSize, double* result);
+	};
+}
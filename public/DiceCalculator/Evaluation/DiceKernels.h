@@ -0,0 +1,43 @@
+#pragma once
+
+#include "DiceCalculator/Evaluation/ConvolutionKernels.h"
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace DiceCalculator::Evaluation
+{
+	// Dice rolling kernels built on eight interleaved xoshiro128++ generators, one per 32-bit lane of an
+	// AVX2 register. A single generator step yields one face for each of eight samples, bounded with
+	// Lemire's multiply-shift method, and the faces are summed in registers across all dice of a node.
+	// Every kernel steps the lanes identically, so all instruction sets produce the same rolls.
+	class DiceKernels
+	{
+	public:
+		using InstructionSet = ConvolutionKernels::InstructionSet;
+
+		constexpr static std::size_t Lanes = 8;
+
+		// Words[i][lane] is word i of the xoshiro128++ state of `lane`.
+		struct State
+		{
+			alignas(32) std::uint32_t Words[4][Lanes] = {};
+		};
+
+		// For every sample i < count, rolls `rolls` dice with faces in [1, sides] and writes their sum to
+		// sums[i] and, unless `firstFaces` is null, the face of the first die to firstFaces[i]. Samples
+		// are rolled in groups of Lanes; the unused lanes of the last group are discarded.
+		using RollKernel = void (*)(State& state, int rolls, std::uint32_t sides, int* sums, int* firstFaces, std::size_t count);
+
+		// Only the scalar and AVX2 kernels exist; other instruction sets are reported as unsupported.
+		static bool IsSupported(InstructionSet instructionSet);
+		static InstructionSet GetBestSupported();
+		static std::string_view GetName(InstructionSet instructionSet);
+
+		// Returns nullptr if the kernel is not compiled in or not supported by this CPU.
+		static RollKernel GetRollKernel(InstructionSet instructionSet);
+
+		// Runs the kernel for GetBestSupported().
+		static void RollDice(State& state, int rolls, std::uint32_t sides, int* sums, int* firstFaces, std::size_t count);
+	};
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include "DiceCalculator/Distribution.h"
+#include "DiceCalculator/Expressions/DiceAst.h"
+
+namespace DiceCalculator::Evaluation
+{
+	// Bounded, thread-safe LRU cache of evaluated distributions, keyed by AST structure: two separately
+	// parsed copies of `1d20 + 5` share an entry. Lookups use DiceAst::GetHash and confirm with IsEqual.
+	class DistributionCache
+	{
+	public:
+		struct Statistics
+		{
+			std::size_t Hits = 0;
+			std::size_t Misses = 0;
+			std::size_t Evictions = 0;
+			std::size_t Size = 0;
+		};
+
+		explicit DistributionCache(std::size_t capacity = 1024);
+
+		// Returns nullptr on a miss. A hit marks the entry as most recently used.
+		std::shared_ptr<const Distribution> Find(const Expressions::DiceAst& node);
+
+		// Stores or replaces the entry for `node`, evicting the least recently used one when full. The
+		// cache keeps `node` alive as its key; nodes not owned by a shared_ptr are not cached.
+		void Insert(const Expressions::DiceAst& node, Distribution distribution);
+
+		void Clear();
+
+		std::size_t GetCapacity() const { return m_Capacity; }
+		Statistics GetStatistics() const;
+
+	private:
+		struct Entry
+		{
+			std::shared_ptr<const Expressions::DiceAst> Key;
+			std::shared_ptr<const Distribution> Value;
+		};
+
+		using EntryList = std::list<Entry>;
+
+		std::size_t m_Capacity;
+		EntryList m_Entries; // Most recently used first.
+		std::unordered_multimap<std::size_t, EntryList::iterator> m_Index;
+		Statistics m_Statistics;
+		mutable std::mutex m_Mutex;
+
+		EntryList::iterator FindEntry(const Expressions::DiceAst& node);
+	};
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "DiceCalculator/Distribution.h"
+#include "DiceCalculator/Evaluation/RollProgram.h"
+#include "DiceCalculator/ThreadPool.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace DiceCalculator::Expressions
+{
+	class DiceAst;
+}
+
+namespace DiceCalculator::Evaluation
+{
+	// Monte Carlo sampling spread over a thread pool. The samples are cut into fixed blocks of
+	// `batchSize`; block b is rolled by a compiled RollProgram on Xoshiro128x8Random(seed, b), whichever
+	// thread runs it. Counts are merged exactly, so the result depends only on the seed, the batch size
+	// and the sample count, never on the number of threads or their timing.
+	class ParallelRollSampler
+	{
+	public:
+		// Blocks are grouped into this many histograms per pool thread.
+		constexpr static std::size_t ChunksPerThread = 4;
+
+		// When SampleAdaptive stops. Sampling ends as soon as every enabled target is met, or earlier once
+		// MaxSamples are drawn or the time budget is spent; targets of 0 are disabled.
+		struct Precision
+		{
+			// Largest standard error sqrt(p * (1 - p) / n) allowed for the probability of any outcome.
+			double MaxStandardError = 0.001;
+
+			// Largest distance between the sampled and the true CDF allowed with probability Confidence,
+			// by the Dvoretzky-Kiefer-Wolfowitz inequality.
+			double MaxKsDistance = 0.0;
+			double Confidence = 0.95;
+
+			std::size_t MinSamples = 10000;
+			std::size_t MaxSamples = 100000000;
+			std::chrono::steady_clock::duration TimeBudget = std::chrono::seconds(2);
+		};
+
+		// Distribution sampled by SampleAdaptive with the error it achieved.
+		struct Estimate
+		{
+			DiceCalculator::Distribution Result;
+			std::size_t Samples = 0;
+			// Largest standard error over all outcomes, i.e. the widest one-sigma error bar.
+			double MaxStandardError = 0.0;
+			// CDF distance that is not exceeded with probability Precision::Confidence.
+			double KsDistance = 0.0;
+			// False if sampling stopped on MaxSamples or the time budget.
+			bool PrecisionMet = false;
+
+			// One-sigma error bar of the probability of `value`.
+			double GetStandardError(int value) const;
+		};
+
+		// Without a thread pool every block runs on the calling thread.
+		explicit ParallelRollSampler(std::uint64_t seed, std::shared_ptr<ThreadPool> threadPool = nullptr, std::size_t batchSize = RollProgram::DefaultBatchSize)
+			: m_Seed(seed), m_ThreadPool(std::move(threadPool)), m_BatchSize(batchSize) {}
+
+		// Rolls `node` `samples` times and returns the normalized distribution of the results.
+		DiceCalculator::Distribution Sample(const DiceCalculator::Expressions::DiceAst& node, std::size_t samples) const;
+		DiceCalculator::Distribution Sample(const RollProgram& program, std::size_t samples) const;
+
+		// Rolls `node` in rounds of whole blocks until `precision` is met. Every round continues the block
+		// sequence of the rounds before it, so the result is reproducible unless the time budget cuts
+		// sampling short.
+		Estimate SampleAdaptive(const DiceCalculator::Expressions::DiceAst& node, const Precision& precision) const;
+		Estimate SampleAdaptive(const RollProgram& program, const Precision& precision) const;
+
+		std::uint64_t GetSeed() const { return m_Seed; }
+		std::size_t GetBatchSize() const { return m_BatchSize; }
+		const std::shared_ptr<ThreadPool>& GetThreadPool() const { return m_ThreadPool; }
+
+	private:
+		std::uint64_t m_Seed;
+		std::shared_ptr<ThreadPool> m_ThreadPool;
+		std::size_t m_BatchSize;
+
+		// Adds the results of blocks [firstBlock, lastBlock) to `counts`; blocks end at sample `samples`.
+		void CountBlocks(const RollProgram& program, std::size_t firstBlock, std::size_t lastBlock, std::size_t samples, DiceCalculator::Distribution& counts) const;
+	};
+}
@@ -3,6 +3,8 @@
 #include "DiceCalculator/Evaluation/DiceAstVisitor.h"
 #include "DiceCalculator/Distribution.h"
 #include "DiceCalculator/IRandom.h"
+#include <utility>
+#include <vector>
 
 namespace DiceCalculator::Evaluation
 {
@@ -15,7 +17,24 @@ namespace DiceCalculator::Evaluation
 			int RolledValue;
 		};
 
-		RollAstVisitor(IRandom& random) : m_Random(random), m_Result(0) {}
+		enum class Tracking
+		{
+			// Every rolled die is recorded.
+			Records,
+			// Only totals are kept, for callers that just build histograms. Operators still get the face
+			// of the first d20, which is all the crit check of AttackRoll needs.
+			TotalsOnly
+		};
+
+		// Dice rolled by a subtree: its records (empty when only totals are tracked) and the face of its
+		// first d20, or 0 if it rolled none.
+		struct RolledDice
+		{
+			std::vector<DiceRollRecord> Records;
+			int FirstD20 = 0;
+		};
+
+		RollAstVisitor(IRandom& random, Tracking tracking = Tracking::Records) : m_Result(0), m_Random(random), m_Tracking(tracking) {}
 
 		void Visit(const DiceCalculator::Expressions::ConstantNode& node) override;
 		void Visit(const DiceCalculator::Expressions::DiceNode& node) override;
@@ -23,19 +42,42 @@ namespace DiceCalculator::Evaluation
 
 		int GetResult() const { return m_Result; }
 
-		const std::vector<DiceRollRecord>& GetDiceRecords() const { return m_DiceRecords; }
-		void SetDiceRecords(const std::vector<DiceRollRecord>& records)
+		Tracking GetTracking() const { return m_Tracking; }
+
+		const std::vector<DiceRollRecord>& GetDiceRecords() const { return m_DiceRecords.Records; }
+		int GetFirstD20() const { return m_DiceRecords.FirstD20; }
+
+		// Moves the dice of the last visited subtree out, so operators can keep them without a copy.
+		RolledDice TakeDice()
+		{
+			RolledDice dice = std::move(m_DiceRecords);
+			m_DiceRecords = {};
+			return dice;
+		}
+
+		// Appends the dice of the last visited subtree to `into`, as if rolled after the dice already there.
+		void AppendDice(RolledDice& into) const
+		{
+			into.Records.insert(into.Records.end(), m_DiceRecords.Records.begin(), m_DiceRecords.Records.end());
+			if (into.FirstD20 == 0)
+			{
+				into.FirstD20 = m_DiceRecords.FirstD20;
+			}
+		}
+
+		void SetDice(RolledDice dice)
 		{
-			m_DiceRecords = records;
+			m_DiceRecords = std::move(dice);
 		}
 
 	private:
 		int m_Result;
 		IRandom& m_Random;
+		Tracking m_Tracking;
 
 		/// <summary>
 		/// Dice rolls
 		/// </summary>
-		std::vector<DiceRollRecord> m_DiceRecords;
+		RolledDice m_DiceRecords;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "DiceCalculator/IRandom.h"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace DiceCalculator::Evaluation
+{
+	// A dice expression lowered to a flat register program by RollProgramCompiler. Running it rolls a
+	// whole column of independent samples per instruction, so sampling neither walks the AST nor makes
+	// virtual calls beyond one IRandom::SumDice per dice instruction. Programs are immutable and can be
+	// run from several threads at once, each with its own Workspace.
+	class RollProgram
+	{
+	public:
+		// Samples per run that keep the register columns of typical expressions in the L1/L2 cache.
+		constexpr static std::size_t DefaultBatchSize = 4096;
+
+		enum class OpCode : std::uint8_t
+		{
+			// Target = Left (an immediate value).
+			Constant,
+			// Target = sum of Left dice with Right sides.
+			Dice,
+			// Target = Left + Right, and likewise for the others below.
+			Add,
+			Subtract,
+			LessThan,
+			LessThanOrEqual,
+			Equal,
+			NotEqual,
+			GreaterThanOrEqual,
+			GreaterThan,
+			// Target = the larger (smaller) of Left and Right, Left on ties; the chosen side keeps its d20.
+			Max,
+			Min,
+			// Target = 1 if the d20 of Left is a critical hit or Left >= Right, 0 if it is a critical miss
+			// or Left < Right.
+			AttackRoll
+		};
+
+		struct Instruction
+		{
+			OpCode Code;
+			std::uint32_t Target;
+			std::int32_t Left;
+			std::int32_t Right;
+		};
+
+		// Register columns of one batch; reusing a workspace across runs avoids reallocating them.
+		struct Workspace
+		{
+			std::vector<int> Values;
+			std::vector<int> D20Faces;
+		};
+
+		RollProgram() = default;
+		RollProgram(std::vector<Instruction> instructions, std::uint32_t registerCount, std::uint32_t resultRegister);
+
+		// Rolls results.size() samples and writes their results.
+		void Run(IRandom& random, std::span<int> results, Workspace& workspace) const;
+
+		const std::vector<Instruction>& GetInstructions() const { return m_Instructions; }
+		std::uint32_t GetRegisterCount() const { return m_RegisterCount; }
+		std::uint32_t GetResultRegister() const { return m_ResultRegister; }
+
+		// Whether any instruction reads the d20 faces, which are only tracked when needed.
+		bool TracksD20() const { return m_TracksD20; }
+
+	private:
+		std::vector<Instruction> m_Instructions;
+		std::uint32_t m_RegisterCount = 0;
+		std::uint32_t m_ResultRegister = 0;
+		bool m_TracksD20 = false;
+	};
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "DiceCalculator/Evaluation/DiceAstVisitor.h"
+#include "DiceCalculator/Evaluation/RollProgram.h"
+#include <cstdint>
+#include <vector>
+
+namespace DiceCalculator::Expressions
+{
+	class DiceAst;
+}
+
+namespace DiceCalculator::Evaluation
+{
+	// Lowers an AST to a RollProgram. Every node becomes instructions that leave its value in a register;
+	// operators lower themselves through DiceOperator::Compile. A register is freed as soon as its one
+	// reader is emitted, so the program needs as many registers as the tree has live intermediate values.
+	class RollProgramCompiler : public Evaluation::DiceAstVisitor
+	{
+	public:
+		void Visit(const DiceCalculator::Expressions::ConstantNode& node) override;
+		void Visit(const DiceCalculator::Expressions::DiceNode& node) override;
+		void Visit(const DiceCalculator::Expressions::OperatorNode& node) override;
+
+		// Register holding the value of the last visited subtree.
+		std::uint32_t GetRegister() const { return m_Register; }
+
+		// Compiles `operand` and returns the register holding its value.
+		std::uint32_t CompileOperand(const DiceCalculator::Expressions::DiceAst& operand);
+
+		// Appends an instruction. Register operands are released, then the target register is allocated
+		// and returned, so the target may reuse an operand's register.
+		std::uint32_t Emit(RollProgram::OpCode code, std::int32_t left, std::int32_t right);
+
+		// The instructions emitted so far, with the value of the last visited tree as the result.
+		RollProgram GetProgram() const;
+
+		static RollProgram Compile(const DiceCalculator::Expressions::DiceAst& node);
+
+	private:
+		std::vector<RollProgram::Instruction> m_Instructions;
+		std::vector<std::uint32_t> m_FreeRegisters;
+		std::uint32_t m_RegisterCount = 0;
+		std::uint32_t m_Register = 0;
+	};
+}
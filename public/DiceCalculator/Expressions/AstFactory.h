@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "DiceCalculator/Expressions/DiceAst.h"
+#include "DiceCalculator/Expressions/ConstantNode.h"
+#include "DiceCalculator/Expressions/DiceNode.h"
+#include "DiceCalculator/Expressions/OperatorNode.h"
+
+namespace DiceCalculator::Expressions
+{
+	// Hash-consing node factory: structurally equal subtrees built through the same factory are the
+	// same object, so an expression becomes a DAG in which every unique subtree exists once.
+	// The factory only holds weak references; nodes live as long as some tree uses them.
+	// Thread-safe.
+	class AstFactory
+	{
+	public:
+		std::shared_ptr<ConstantNode> MakeConstant(int value);
+		std::shared_ptr<DiceNode> MakeDice(int rolls, int sides);
+
+		// Operands are interned first, so they may come from anywhere.
+		std::shared_ptr<OperatorNode> MakeOperator(std::shared_ptr<DiceCalculator::Operators::DiceOperator> op, std::vector<std::shared_ptr<DiceAst>> operands);
+
+		// Returns the interned equivalent of an arbitrary tree.
+		std::shared_ptr<DiceAst> Intern(const std::shared_ptr<DiceAst>& ast);
+
+		// Number of live unique nodes.
+		std::size_t GetNodeCount();
+
+	private:
+		std::unordered_multimap<std::size_t, std::weak_ptr<DiceAst>> m_Nodes;
+		std::size_t m_SweepThreshold = 1024;
+		std::mutex m_Mutex;
+
+		// Returns the first live node in the hash bucket that satisfies `matches`, dropping expired
+		// entries on the way. Must be called with the mutex held.
+		template<typename Node, typename Predicate>
+		std::shared_ptr<Node> FindLocked(std::size_t hash, Predicate matches);
+
+		void AddLocked(std::size_t hash, const std::shared_ptr<DiceAst>& node);
+	};
+}
@@ -8,16 +8,19 @@ namespace DiceCalculator::Expressions
     {
     public:
 
-        explicit ConstantNode(int v) : m_Value(v) {}
+        explicit ConstantNode(int v);
 
         void Accept(DiceCalculator::Evaluation::DiceAstVisitor& v) const override;
 
         int GetValue() const;
 
         bool IsEqual(const DiceAst& other) const override;
+        std::size_t GetHash() const override { return m_Hash; }
+        static std::size_t ComputeHash(int value);
 
     private:
         int m_Value;
+        std::size_t m_Hash;
     };
 
 }
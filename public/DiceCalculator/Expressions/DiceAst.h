@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstddef>
+#include <memory>
+
 namespace DiceCalculator
 {
 	namespace Evaluation
@@ -10,12 +13,16 @@ namespace DiceCalculator
 
 namespace DiceCalculator::Expressions
 {
-	class DiceAst
+	class DiceAst : public std::enable_shared_from_this<DiceAst>
 	{
 	public:
 		virtual ~DiceAst() = default;
 
 		virtual void Accept(DiceCalculator::Evaluation::DiceAstVisitor& visitor) const = 0;
 		virtual bool IsEqual(const DiceAst& other) const = 0;
+
+		// Structural hash, consistent with IsEqual: equal trees hash equally. Nodes are immutable, so
+		// the hash is computed once at construction.
+		virtual std::size_t GetHash() const = 0;
 	};
 }
\ No newline at end of file
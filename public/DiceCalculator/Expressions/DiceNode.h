@@ -8,17 +8,20 @@ namespace DiceCalculator::Expressions
     {
     public:
 
-        explicit DiceNode(int rolls, int sides) : m_Rolls(rolls), m_Sides(sides) {}
+        explicit DiceNode(int rolls, int sides);
 
         int GetRolls() const { return m_Rolls; }
         int GetSides() const { return m_Sides; }
 
         void Accept(DiceCalculator::Evaluation::DiceAstVisitor& v) const override;
         bool IsEqual(const DiceAst& other) const override;
+        std::size_t GetHash() const override { return m_Hash; }
+        static std::size_t ComputeHash(int rolls, int sides);
 
     private:
         int m_Rolls;
         int m_Sides;
+        std::size_t m_Hash;
     };
 
 }
\ No newline at end of file
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+#include "DiceCalculator/Expressions/DiceAst.h"
+#include "DiceCalculator/Operators/DiceOperator.h"
+
+namespace DiceCalculator::Expressions
+{
+	class AstFactory;
+
+	// A read-only copy of an expression whose nodes sit in one contiguous array, with operands
+	// referenced by index instead of by shared_ptr. Nodes are stored in post-order: operands come
+	// before the operators that use them and the root is the last node, so one forward pass visits
+	// the tree bottom up. Subtrees shared in the source (see AstFactory) stay shared, and equal
+	// operators are stored once. Nodes are plain data, so destroying a FlatAst frees a few blocks
+	// whatever the size of the expression.
+	class FlatAst
+	{
+	public:
+		enum class NodeKind : std::uint8_t
+		{
+			Constant,
+			Dice,
+			Operator
+		};
+
+		struct Node
+		{
+			NodeKind Kind;
+			// The value of a constant, or the number of rolls of a dice node.
+			std::int32_t Value;
+			// The sides of a dice node.
+			std::int32_t Sides;
+			// Operator nodes: the index of the operator in GetOperators(), and where their operand
+			// indices start in the operand table and how many there are.
+			std::uint32_t Operator;
+			std::uint32_t FirstOperand;
+			std::uint32_t OperandCount;
+		};
+
+		FlatAst() = default;
+		explicit FlatAst(const DiceAst& root);
+
+		std::span<const Node> GetNodes() const { return m_Nodes; }
+		const Node& GetRoot() const { return m_Nodes.back(); }
+		bool IsEmpty() const { return m_Nodes.empty(); }
+
+		// Indices into GetNodes() of the operands of an operator node, in order.
+		std::span<const std::uint32_t> GetOperands(const Node& node) const
+		{
+			return std::span<const std::uint32_t>(m_Operands).subspan(node.FirstOperand, node.OperandCount);
+		}
+
+		const DiceCalculator::Operators::DiceOperator& GetOperator(const Node& node) const { return *m_Operators[node.Operator]; }
+		const std::vector<std::shared_ptr<DiceCalculator::Operators::DiceOperator>>& GetOperators() const { return m_Operators; }
+
+		// Rebuilds the expression as a tree of nodes from `factory`, for the visitors.
+		std::shared_ptr<DiceAst> ToAst(AstFactory& factory) const;
+
+	private:
+		std::vector<Node> m_Nodes;
+		std::vector<std::uint32_t> m_Operands;
+		std::vector<std::shared_ptr<DiceCalculator::Operators::DiceOperator>> m_Operators;
+	};
+}
@@ -14,20 +14,20 @@ namespace DiceCalculator::Expressions
     public:
         
         OperatorNode(std::shared_ptr<DiceCalculator::Operators::DiceOperator> op,
-            std::vector<std::shared_ptr<DiceAst>> ops)
-            : m_Operator(std::move(op)), m_Operands(std::move(ops))
-        {
-        }
+            std::vector<std::shared_ptr<DiceAst>> ops);
 
         void Accept(Evaluation::DiceAstVisitor& v) const override;
 
         const std::vector<std::shared_ptr<DiceAst>>& GetOperands() const;
 		const std::shared_ptr<DiceCalculator::Operators::DiceOperator>& GetOperator() const { return m_Operator; }
         bool IsEqual(const DiceAst& other) const override;
+        std::size_t GetHash() const override { return m_Hash; }
+        static std::size_t ComputeHash(const DiceCalculator::Operators::DiceOperator* op, const std::vector<std::shared_ptr<DiceAst>>& operands);
 
     private:
         std::shared_ptr<DiceCalculator::Operators::DiceOperator> m_Operator;
         std::vector<std::shared_ptr<DiceAst>> m_Operands;
+        std::size_t m_Hash;
 
     };
 
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <cstddef>
+
+namespace DiceCalculator
+{
+	// Mixes `value` into `seed` (the boost::hash_combine recipe).
+	inline std::size_t HashCombine(std::size_t seed, std::size_t value)
+	{
+		return seed ^ (value + static_cast<std::size_t>(0x9e3779b97f4a7c15ull) + (seed << 6) + (seed >> 2));
+	}
+}
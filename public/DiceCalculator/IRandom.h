@@ -1,10 +1,59 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <span>
+
 namespace DiceCalculator
 {
+	// Source of uniform integers. The interface has exactly two levels:
+	// - NextInt draws one value, for callers that roll a single expression at a time.
+	// - Fill and SumDice draw whole columns with one virtual call, for samplers that roll many independent
+	//   samples at once. Fill is the primitive, and SumDice is built on it by default.
+	// Generators override only what they can do faster: a scalar generator hoists the per-range setup
+	// of Fill out of its loop, and a vectorized one also keeps the running sums of SumDice in registers.
 	class IRandom
 	{
 	public:
+		virtual ~IRandom() = default;
+
 		virtual int NextInt(int minInclusive, int maxInclusive) = 0;
+
+		// Fills `out` with values in [minInclusive, maxInclusive].
+		virtual void Fill(std::span<int> out, int minInclusive, int maxInclusive)
+		{
+			for (int& value : out)
+			{
+				value = NextInt(minInclusive, maxInclusive);
+			}
+		}
+
+		// Rolls `rolls` dice with faces in [1, sides] for every element of `sums` and writes their sum.
+		// Unless `firstFaces` is empty, it receives the face of the first die of every sum. The default
+		// draws one Fill per die and chunk of sums into a stack buffer, so it never allocates.
+		virtual void SumDice(std::span<int> sums, std::span<int> firstFaces, int rolls, int sides)
+		{
+			constexpr std::size_t ChunkSize = 256;
+			std::array<int, ChunkSize> faces;
+			for (std::size_t first = 0; first < sums.size(); first += ChunkSize)
+			{
+				const std::size_t count = std::min(ChunkSize, sums.size() - first);
+				const std::span<int> chunk = sums.subspan(first, count);
+				std::fill(chunk.begin(), chunk.end(), 0);
+				for (int die = 0; die < rolls; ++die)
+				{
+					Fill(std::span<int>(faces.data(), count), 1, sides);
+					for (std::size_t i = 0; i < count; ++i)
+					{
+						chunk[i] += faces[i];
+					}
+					if (die == 0 && !firstFaces.empty())
+					{
+						std::copy_n(faces.begin(), count, firstFaces.begin() + static_cast<std::ptrdiff_t>(first));
+					}
+				}
+			}
+		}
 	};
-}
\ No newline at end of file
+}
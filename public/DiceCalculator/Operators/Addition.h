@@ -5,6 +5,7 @@
 #include "DiceCalculator/Evaluation/RollAstVisitor.h"
 #include "DiceCalculator/Evaluation/ConvolutionAstVisitor.h"
 #include "DiceCalculator/Evaluation/CombinationAstVisitor.h"
+#include "DiceCalculator/Evaluation/RollProgramCompiler.h"
 #include "DiceCalculator/Operators/IRegistry.h"
 
 namespace DiceCalculator::Operators
@@ -12,10 +13,11 @@ namespace DiceCalculator::Operators
 	class Addition : public DiceOperator
 	{
 	public:
-		bool Validate(std::vector<std::shared_ptr<DiceCalculator::Expressions::DiceAst>> operands) const override;
-		int Evaluate(DiceCalculator::Evaluation::RollAstVisitor& visitor, std::vector<std::shared_ptr<DiceCalculator::Expressions::DiceAst>> operands) const override;
-		Distribution Evaluate(DiceCalculator::Evaluation::ConvolutionAstVisitor& visitor, std::vector<std::shared_ptr<DiceCalculator::Expressions::DiceAst>> operands) const override;
-		std::vector<Combination> Evaluate(DiceCalculator::Evaluation::CombinationAstVisitor& visitor, std::vector<std::shared_ptr<DiceCalculator::Expressions::DiceAst>> operands) const override;
+		bool Validate(Operands operands) const override;
+		int Evaluate(DiceCalculator::Evaluation::RollAstVisitor& visitor, Operands operands) const override;
+		Distribution Evaluate(DiceCalculator::Evaluation::ConvolutionAstVisitor& visitor, Operands operands) const override;
+		std::unique_ptr<DiceCalculator::Evaluation::CombinationStream> Evaluate(DiceCalculator::Evaluation::CombinationAstVisitor& visitor, Operands operands) const override;
+		std::uint32_t Compile(DiceCalculator::Evaluation::RollProgramCompiler& compiler, Operands operands) const override;
 		bool IsEqual(const DiceOperator& other) const override;
 		static std::vector<RegistryEntry> Register();
 	};
@@ -7,6 +7,7 @@
 #include "DiceCalculator/Expressions/DiceNode.h"
 #include "DiceCalculator/Expressions/OperatorNode.h"
 #include "DiceCalculator/Evaluation/CombinationAstVisitor.h"
+#include "DiceCalculator/Evaluation/RollProgramCompiler.h"
 #include "DiceCalculator/Operators/IRegistry.h"
 
 namespace DiceCalculator::Operators
@@ -14,21 +15,21 @@ namespace DiceCalculator::Operators
 	class AttackRoll : public DiceOperator
 	{
 	public:
+		constexpr static int CriticalHitThreshold = 20;
+		constexpr static int CriticalMissThreshold = 1;
 
 		AttackRoll() {}
 
-		bool Validate(std::vector<std::shared_ptr<DiceCalculator::Expressions::DiceAst>> operands) const override;
-		int Evaluate(DiceCalculator::Evaluation::RollAstVisitor& visitor, std::vector<std::shared_ptr<DiceCalculator::Expressions::DiceAst>> operands) const override;
-		Distribution Evaluate(DiceCalculator::Evaluation::ConvolutionAstVisitor& visitor, std::vector<std::shared_ptr<DiceCalculator::Expressions::DiceAst>> operands) const override;
-		std::vector<Combination> Evaluate(DiceCalculator::Evaluation::CombinationAstVisitor& visitor, std::vector<std::shared_ptr<DiceCalculator::Expressions::DiceAst>> operands) const override;
+		bool Validate(Operands operands) const override;
+		int Evaluate(DiceCalculator::Evaluation::RollAstVisitor& visitor, Operands operands) const override;
+		Distribution Evaluate(DiceCalculator::Evaluation::ConvolutionAstVisitor& visitor, Operands operands) const override;
+		std::unique_ptr<DiceCalculator::Evaluation::CombinationStream> Evaluate(DiceCalculator::Evaluation::CombinationAstVisitor& visitor, Operands operands) const override;
+		std::uint32_t Compile(DiceCalculator::Evaluation::RollProgramCompiler& compiler, Operands operands) const override;
 		bool IsEqual(const DiceOperator& other) const override;
 
 		static std::vector<RegistryEntry> Register();
 
 	private:
-		constexpr static int CriticalHitThreshold = 20;
-		constexpr static int CriticalMissThreshold = 1;
-
 		class DiceCounterVisitor : public DiceCalculator::Evaluation::DiceAstVisitor
 		{
 		public:
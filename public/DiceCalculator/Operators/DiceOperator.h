@@ -1,7 +1,10 @@
 #pragma once
 
+#include <cstdint>
 #include <vector>
 #include <memory>
+#include <span>
+#include <typeinfo>
 #include "DiceCalculator/Distribution.h"
 #include "DiceCalculator/Combination.h"
 
@@ -10,6 +13,8 @@ namespace DiceCalculator::Evaluation
 	class RollAstVisitor;
 	class ConvolutionAstVisitor;
 	class CombinationAstVisitor;
+	class CombinationStream;
+	class RollProgramCompiler;
 }
 
 namespace DiceCalculator::Expressions
@@ -19,16 +24,26 @@ namespace DiceCalculator::Expressions
 
 namespace DiceCalculator::Operators
 {
+	// Operands of the operator node being evaluated. A non-owning view, valid only during the call; the
+	// node keeps the operands alive, so operators never copy the vector or touch the reference counts.
+	using Operands = std::span<const std::shared_ptr<DiceCalculator::Expressions::DiceAst>>;
+
 	class DiceOperator
 	{
 	public:
 		virtual ~DiceOperator() = default;
 
 		virtual bool IsEqual(const DiceOperator& other) const = 0;
-		virtual bool Validate(std::vector<std::shared_ptr<DiceCalculator::Expressions::DiceAst>> operands) const = 0;
 
-		virtual int Evaluate(DiceCalculator::Evaluation::RollAstVisitor& visitor, std::vector<std::shared_ptr<DiceCalculator::Expressions::DiceAst>> operands) const = 0;
-		virtual Distribution Evaluate(DiceCalculator::Evaluation::ConvolutionAstVisitor& visitor, std::vector<std::shared_ptr<DiceCalculator::Expressions::DiceAst>> operands) const = 0;
-		virtual std::vector<Combination> Evaluate(DiceCalculator::Evaluation::CombinationAstVisitor& visitor, std::vector<std::shared_ptr<DiceCalculator::Expressions::DiceAst>> operands) const = 0;
+		// Must agree with IsEqual. Operators without parameters are identified by their type alone.
+		virtual std::size_t GetHash() const { return typeid(*this).hash_code(); }
+		virtual bool Validate(Operands operands) const = 0;
+
+		virtual int Evaluate(DiceCalculator::Evaluation::RollAstVisitor& visitor, Operands operands) const = 0;
+		virtual Distribution Evaluate(DiceCalculator::Evaluation::ConvolutionAstVisitor& visitor, Operands operands) const = 0;
+		virtual std::unique_ptr<DiceCalculator::Evaluation::CombinationStream> Evaluate(DiceCalculator::Evaluation::CombinationAstVisitor& visitor, Operands operands) const = 0;
+
+		// Emits the instructions computing this operator and returns the register holding its value.
+		virtual std::uint32_t Compile(DiceCalculator::Evaluation::RollProgramCompiler& compiler, Operands operands) const = 0;
 	};
 }
\ No newline at end of file
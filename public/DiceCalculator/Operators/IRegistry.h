@@ -40,5 +40,9 @@ namespace DiceCalculator::Operators
         virtual const RegistryEntry& GetEntry(std::string_view name, Arity arity) const = 0;
 
         virtual std::vector<RegistryEntry> GetOperatorsByArity(Arity arity) const = 0;
+
+        // Changes whenever an entry is registered, so that consumers can tell when derived data
+        // (such as a parser's grammar) is stale.
+        virtual std::size_t GetVersion() const = 0;
     };
 }
\ No newline at end of file
@@ -74,6 +74,7 @@ namespace DiceCalculator::Operators
             {
                 throw std::runtime_error("Function already registered: " + it->second.Name);
             }
+            ++m_Version;
         }
 
         // Create by explicit name + arity
@@ -112,8 +113,14 @@ namespace DiceCalculator::Operators
             return result;
 		}
 
+        std::size_t GetVersion() const override
+        {
+            return m_Version;
+        }
+
     private:
         std::unordered_map<Key, RegistryEntry, KeyHash> m_Registry;
+        std::size_t m_Version = 0;
 	};
 
 }
\ No newline at end of file
@@ -2,9 +2,16 @@
 
 #include "DiceCalculator/Parsing/IParser.h"
 #include "DiceCalculator/Operators/IRegistry.h"
+#include "DiceCalculator/Expressions/AstFactory.h"
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
 
 namespace DiceCalculator::Parsing
 {
+	// Parse may be called concurrently from several threads. The grammar is built on first use and
+	// rebuilt only when the registry's version changes.
 	class BoostSpiritParser : public IParser
 	{
 	public:
@@ -16,5 +23,16 @@ namespace DiceCalculator::Parsing
 	private:
 		std::string ReconstructInternal(const std::shared_ptr<DiceCalculator::Expressions::DiceAst>& ast, bool isChildOfOperator) const;
 		std::shared_ptr<Operators::IRegistry> m_Registry;
+
+		struct Grammar;
+		std::shared_ptr<const Grammar> GetGrammar() const;
+
+		// Parses in flight keep their grammar alive while a rebuild replaces it.
+		mutable std::mutex m_GrammarMutex;
+		mutable std::shared_ptr<const Grammar> m_Grammar;
+		mutable std::size_t m_GrammarVersion = 0;
+
+		// Shared by all parses, so repeated expressions and subexpressions resolve to the same nodes.
+		std::shared_ptr<DiceCalculator::Expressions::AstFactory> m_Factory;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "DiceCalculator/IRandom.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace DiceCalculator
+{
+	// Counter-based Philox4x32-10 generator (Salmon et al., "Parallel random numbers: as easy as 1, 2,
+	// 3"). Every (seed, stream) pair names an independent sequence that can be created in O(1), so
+	// parallel samplers can give each block of work its own reproducible stream.
+	class PhiloxRandom : public IRandom
+	{
+	public:
+		using Counter = std::array<std::uint32_t, 4>;
+		using Key = std::array<std::uint32_t, 2>;
+
+		explicit PhiloxRandom(std::uint64_t seed, std::uint64_t stream = 0);
+
+		virtual ~PhiloxRandom() = default;
+		int NextInt(int minInclusive, int maxInclusive) override;
+		void Fill(std::span<int> out, int minInclusive, int maxInclusive) override;
+
+		// Next raw 32-bit output.
+		std::uint32_t NextUInt32();
+
+		// The Philox4x32-10 bijection: four output words for one counter value under `key`.
+		static Counter Generate(Counter counter, Key key);
+
+	private:
+		Key m_Key;
+		// Words 0-1 count generated blocks, words 2-3 hold the stream.
+		Counter m_Counter;
+		Counter m_Block = {};
+		std::size_t m_BlockPosition = 4;
+
+		// Uniform in [0, range) by rejection, so that no value is favoured; range 0 means 2^32.
+		std::uint32_t NextBelow(std::uint32_t range);
+	};
+}
@@ -13,6 +13,7 @@ namespace DiceCalculator
 
 		virtual ~StdRandom() = default;
 		int NextInt(int minInclusive, int maxInclusive) override;
+		void Fill(std::span<int> out, int minInclusive, int maxInclusive) override;
 
 	private:
 		std::random_device m_RandomDevice;
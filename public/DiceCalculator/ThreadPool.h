@@ -0,0 +1,59 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace DiceCalculator
+{
+	// Fixed-size work-stealing thread pool. Every worker owns a task deque: it pushes and pops its own
+	// tasks at the back and, when it runs dry, steals from the front of the other deques. Tasks
+	// submitted from outside the pool go to a shared injection queue.
+	class ThreadPool
+	{
+	public:
+		// A thread count of 0 uses std::thread::hardware_concurrency().
+		explicit ThreadPool(std::size_t threadCount = 0);
+		~ThreadPool();
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		std::size_t GetThreadCount() const { return m_Threads.size(); }
+
+		void Submit(std::function<void()> task);
+
+		// Calls body(0), ..., body(count - 1) and returns once all calls have finished. The caller and
+		// the workers claim indices from the same counter, so the caller runs every index no worker has
+		// started and never waits on a task that is still queued; ForEach can be nested inside pool tasks
+		// without deadlocking. The first exception thrown by `body` is rethrown after all calls have
+		// finished.
+		void ForEach(std::size_t count, const std::function<void(std::size_t)>& body);
+
+	private:
+		struct WorkQueue
+		{
+			std::mutex Mutex;
+			std::deque<std::function<void()>> Tasks;
+		};
+
+		std::vector<std::unique_ptr<WorkQueue>> m_Queues;
+		std::vector<std::thread> m_Threads;
+
+		std::mutex m_SleepMutex;
+		std::condition_variable m_WakeUp;
+		std::atomic<std::size_t> m_Pending = 0;
+		bool m_Stopping = false;
+
+		void WorkerLoop(std::size_t index);
+		bool TryRunOne();
+		std::function<void()> TryTake(std::size_t ownQueue);
+		std::size_t GetInjectionQueue() const { return m_Queues.size() - 1; }
+	};
+}
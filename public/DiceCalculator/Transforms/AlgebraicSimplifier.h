@@ -0,0 +1,21 @@
+#pragma once
+
+#include <memory>
+#include "DiceCalculator/Expressions/DiceAst.h"
+
+namespace DiceCalculator::Transforms
+{
+	// Rewrites an expression into a cheaper one with the same distribution:
+	// - nested sums and differences become one signed sum, e.g. (1d20 + 5) + 3 - 2 is 1d20 + 6;
+	// - its constants are folded into one, and dice of the same size and sign are pooled, so
+	//   2d6 + 1d20 + 1d6 becomes 3d6 + 1d20;
+	// - any other operator whose operands are all constants is replaced by its value.
+	// Positive terms come first, in order of first appearance, then negative ones. Pooling keeps the
+	// number of dice of each size, so AttackRoll operands stay valid. Subtrees that need no change are
+	// shared with the input.
+	class AlgebraicSimplifier
+	{
+	public:
+		static std::shared_ptr<DiceCalculator::Expressions::DiceAst> Simplify(const std::shared_ptr<DiceCalculator::Expressions::DiceAst>& ast);
+	};
+}
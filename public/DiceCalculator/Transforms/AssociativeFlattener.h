@@ -0,0 +1,17 @@
+#pragma once
+
+#include <memory>
+#include "DiceCalculator/Expressions/DiceAst.h"
+
+namespace DiceCalculator::Transforms
+{
+	// Rewrites chains of associative operators into single n-ary operator nodes, e.g. the left-deep
+	// (a + b) + c produced by the parser becomes +(a, b, c) and (a - b) - c becomes -(a, b, c).
+	// The result evaluates identically with every visitor; subtrees that need no change are shared
+	// with the input.
+	class AssociativeFlattener
+	{
+	public:
+		static std::shared_ptr<DiceCalculator::Expressions::DiceAst> Flatten(const std::shared_ptr<DiceCalculator::Expressions::DiceAst>& ast);
+	};
+}
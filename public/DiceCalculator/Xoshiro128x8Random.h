@@ -0,0 +1,38 @@
+#pragma once
+
+#include "DiceCalculator/IRandom.h"
+#include "DiceCalculator/Evaluation/DiceKernels.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace DiceCalculator
+{
+	// Eight interleaved xoshiro128++ generators driven by Evaluation::DiceKernels, so that SumDice and
+	// Fill draw eight bounded faces per step with AVX2 where the CPU has it. Every (seed, stream) pair
+	// seeds its own generator in O(1), for samplers that give each block of work a stream.
+	class Xoshiro128x8Random : public IRandom
+	{
+	public:
+		using InstructionSet = Evaluation::DiceKernels::InstructionSet;
+
+		// Takes the state of lane i from the Philox4x32-10 block at counter i of PhiloxRandom(seed, stream),
+		// so distinct streams of one seed never start a lane from the same state. Uses the best kernel the
+		// CPU supports unless `instructionSet` names another supported one.
+		explicit Xoshiro128x8Random(std::uint64_t seed, std::uint64_t stream = 0);
+		Xoshiro128x8Random(std::uint64_t seed, std::uint64_t stream, InstructionSet instructionSet);
+
+		virtual ~Xoshiro128x8Random() = default;
+		// Spends a whole eight-lane step on one value; bulk callers should use Fill or SumDice.
+		int NextInt(int minInclusive, int maxInclusive) override;
+		void Fill(std::span<int> out, int minInclusive, int maxInclusive) override;
+		void SumDice(std::span<int> sums, std::span<int> firstFaces, int rolls, int sides) override;
+
+		InstructionSet GetInstructionSet() const { return m_InstructionSet; }
+
+	private:
+		Evaluation::DiceKernels::State m_State;
+		InstructionSet m_InstructionSet;
+		Evaluation::DiceKernels::RollKernel m_Kernel;
+	};
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "DiceCalculator/IRandom.h"
+
+#include <array>
+#include <cstdint>
+
+namespace DiceCalculator
+{
+	// xoshiro256++ generator (Blackman and Vigna, "Scrambled linear pseudorandom number generators")
+	// with Lemire's nearly divisionless bounded integers ("Fast random integer generation in an
+	// interval"). Every 64-bit output is handed out as two 32-bit halves, and Fill computes the
+	// rejection threshold once per call, so a column of dice costs a few instructions per face.
+	class Xoshiro256Random : public IRandom
+	{
+	public:
+		using State = std::array<std::uint64_t, 4>;
+
+		// Expands `seed` into the full state with SplitMix64, as recommended by the authors.
+		explicit Xoshiro256Random(std::uint64_t seed);
+		// Starts from a raw state, which must not be all zeros.
+		explicit Xoshiro256Random(const State& state);
+
+		virtual ~Xoshiro256Random() = default;
+		int NextInt(int minInclusive, int maxInclusive) override;
+		void Fill(std::span<int> out, int minInclusive, int maxInclusive) override;
+
+		// Next raw 64-bit output.
+		std::uint64_t NextUInt64();
+		// Next raw 32-bit output.
+		std::uint32_t NextUInt32();
+
+	private:
+		State m_State;
+		std::uint32_t m_SpareHalf = 0;
+		bool m_HasSpareHalf = false;
+
+		// Uniform in [0, range) for range > 0. `threshold` is 2^32 mod range; the division computing it is
+		// only needed when a draw lands in the biased low region, so callers may pass it precomputed.
+		std::uint32_t NextBelow(std::uint32_t range, std::uint32_t threshold);
+	};
+}
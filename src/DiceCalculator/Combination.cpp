@@ -0,0 +1,275 @@
+#include "DiceCalculator/Combination.h"
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+namespace DiceCalculator
+{
+	namespace
+	{
+		using Group = Combination::RollLayout::Group;
+
+		bool MultiplyChecked(std::uint64_t left, std::uint64_t right, std::uint64_t& product)
+		{
+			if (left != 0 && right > std::numeric_limits<std::uint64_t>::max() / left)
+			{
+				return false;
+			}
+			product = left * right;
+			return true;
+		}
+
+		// C(n, k), or false if it does not fit 64 bits. Every step is reduced by a gcd first, so the
+		// intermediate values never exceed the binomials C(n - k + i, i) on the way to the result.
+		bool BinomialChecked(std::uint64_t n, std::uint64_t k, std::uint64_t& result)
+		{
+			k = std::min(k, n - k);
+			result = 1;
+			for (std::uint64_t i = 1; i <= k; ++i)
+			{
+				const std::uint64_t divisor = std::gcd(result, i);
+				const std::uint64_t factor = (n - k + i) / (i / divisor);
+				if (!MultiplyChecked(result / divisor, factor, result))
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		std::uint64_t Binomial(std::uint64_t n, std::uint64_t k)
+		{
+			std::uint64_t result = 0;
+			BinomialChecked(n, k, result);
+			return result;
+		}
+
+		std::uint64_t Power(std::uint64_t base, int exponent)
+		{
+			std::uint64_t result = 1;
+			for (int i = 0; i < exponent; ++i)
+			{
+				result *= base;
+			}
+			return result;
+		}
+
+		// Number of distinct face lists of `group`, or false if it does not fit 64 bits.
+		bool CountGroup(const Group& group, std::uint64_t& count)
+		{
+			const auto sides = static_cast<std::uint64_t>(group.Sides);
+			if (group.Sorted)
+			{
+				// Multisets of Rolls faces out of Sides.
+				return BinomialChecked(static_cast<std::uint64_t>(group.Rolls) + sides - 1, static_cast<std::uint64_t>(group.Rolls), count);
+			}
+
+			count = 1;
+			for (int i = 0; i < group.Rolls; ++i)
+			{
+				if (!MultiplyChecked(count, sides, count))
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		// Number of non-decreasing sequences of `length` faces in [face, sides].
+		std::uint64_t CountSortedTails(int length, int face, int sides)
+		{
+			return Binomial(static_cast<std::uint64_t>(length + sides - face), static_cast<std::uint64_t>(length));
+		}
+
+		struct LayoutRegistry
+		{
+			std::mutex Mutex;
+			std::map<std::vector<Group>, std::unique_ptr<Combination::RollLayout>> Layouts;
+		};
+
+		LayoutRegistry& GetRegistry()
+		{
+			static LayoutRegistry registry;
+			return registry;
+		}
+	}
+
+	Combination::RollLayout::RollLayout(std::vector<Group> groups) :
+		m_Groups(std::move(groups)), m_GroupCounts(m_Groups.size()), m_GroupStrides(m_Groups.size()), m_GroupStarts(m_Groups.size())
+	{
+		for (std::size_t i = 0; i < m_Groups.size(); ++i)
+		{
+			m_GroupStarts[i] = m_RollCount;
+			m_RollCount += static_cast<std::size_t>(m_Groups[i].Rolls);
+		}
+
+		// The last group is the least significant digit, as the last die turns fastest in enumeration.
+		for (std::size_t i = m_Groups.size(); i > 0; --i)
+		{
+			m_GroupStrides[i - 1] = m_Count;
+			if (!CountGroup(m_Groups[i - 1], m_GroupCounts[i - 1]) || !MultiplyChecked(m_Count, m_GroupCounts[i - 1], m_Count))
+			{
+				throw std::runtime_error("Combination has too many dice to index its rolls.");
+			}
+		}
+	}
+
+	const Combination::RollLayout& Combination::RollLayout::Get(std::vector<Group> groups)
+	{
+		std::erase_if(groups, [](const Group& group) { return group.Rolls <= 0; });
+		if (std::any_of(groups.begin(), groups.end(), [](const Group& group) { return group.Sides < 1; }))
+		{
+			throw std::invalid_argument("Rolled dice need at least one side.");
+		}
+
+		LayoutRegistry& registry = GetRegistry();
+		std::lock_guard lock(registry.Mutex);
+		auto it = registry.Layouts.find(groups);
+		if (it == registry.Layouts.end())
+		{
+			auto layout = std::unique_ptr<RollLayout>(new RollLayout(groups));
+			it = registry.Layouts.emplace(std::move(groups), std::move(layout)).first;
+		}
+		return *it->second;
+	}
+
+	const Combination::RollLayout& Combination::RollLayout::Concatenate(std::span<const RollLayout* const> layouts)
+	{
+		std::vector<Group> groups;
+		for (const RollLayout* layout : layouts)
+		{
+			if (layout != nullptr)
+			{
+				groups.insert(groups.end(), layout->m_Groups.begin(), layout->m_Groups.end());
+			}
+		}
+		return Get(std::move(groups));
+	}
+
+	Combination::Roll Combination::RollLayout::Decode(std::uint64_t index, std::size_t position) const
+	{
+		if (position >= m_RollCount)
+		{
+			throw std::out_of_range("Roll position is out of range.");
+		}
+
+		const std::size_t g = static_cast<std::size_t>(std::upper_bound(m_GroupStarts.begin(), m_GroupStarts.end(), position) - m_GroupStarts.begin()) - 1;
+		const Group& group = m_Groups[g];
+		const int die = static_cast<int>(position - m_GroupStarts[g]);
+		std::uint64_t rank = (index / m_GroupStrides[g]) % m_GroupCounts[g];
+
+		if (!group.Sorted)
+		{
+			const std::uint64_t digit = (rank / Power(static_cast<std::uint64_t>(group.Sides), group.Rolls - 1 - die)) % static_cast<std::uint64_t>(group.Sides);
+			return Roll{ group.Sides, static_cast<int>(digit) + 1 };
+		}
+
+		// Unrank the multiset: each face is skipped over as long as the rank lies beyond all the
+		// sequences that continue with it.
+		int face = 1;
+		for (int i = 0;; ++i)
+		{
+			while (true)
+			{
+				const std::uint64_t tails = CountSortedTails(group.Rolls - i - 1, face, group.Sides);
+				if (rank < tails)
+				{
+					break;
+				}
+				rank -= tails;
+				++face;
+			}
+			if (i == die)
+			{
+				return Roll{ group.Sides, face };
+			}
+		}
+	}
+
+	std::uint64_t Combination::RollLayout::Encode(std::span<const Roll> rolls) const
+	{
+		if (rolls.size() != m_RollCount)
+		{
+			throw std::out_of_range("Rolls do not match the roll layout.");
+		}
+
+		std::uint64_t index = 0;
+		for (std::size_t g = 0; g < m_Groups.size(); ++g)
+		{
+			const Group& group = m_Groups[g];
+			std::uint64_t rank = 0;
+			int previous = 1;
+			for (int die = 0; die < group.Rolls; ++die)
+			{
+				const Roll& roll = rolls[m_GroupStarts[g] + static_cast<std::size_t>(die)];
+				if (roll.Sides != group.Sides || roll.Value < 1 || roll.Value > group.Sides || (group.Sorted && roll.Value < previous))
+				{
+					throw std::out_of_range("Roll does not fit the roll layout.");
+				}
+
+				if (group.Sorted)
+				{
+					for (int face = previous; face < roll.Value; ++face)
+					{
+						rank += CountSortedTails(group.Rolls - die - 1, face, group.Sides);
+					}
+					previous = roll.Value;
+				}
+				else
+				{
+					rank = rank * static_cast<std::uint64_t>(group.Sides) + static_cast<std::uint64_t>(roll.Value - 1);
+				}
+			}
+			index += rank * m_GroupStrides[g];
+		}
+		return index;
+	}
+
+	Combination::RollList::RollList(std::initializer_list<Roll> rolls)
+	{
+		if (rolls.size() == 0)
+		{
+			return;
+		}
+
+		std::vector<RollLayout::Group> groups;
+		groups.reserve(rolls.size());
+		for (const Roll& roll : rolls)
+		{
+			if (roll.Sides < 1)
+			{
+				throw std::out_of_range("Roll does not fit the roll layout.");
+			}
+			groups.push_back(RollLayout::Group{ 1, roll.Sides, false });
+		}
+
+		const RollLayout& layout = RollLayout::Get(std::move(groups));
+		m_Index = layout.Encode(std::span<const Roll>(rolls.begin(), rolls.size()));
+		m_Layout = &layout;
+	}
+
+	std::size_t Combination::RollList::FindSides(int sides) const
+	{
+		if (m_Layout == nullptr)
+		{
+			return 0;
+		}
+
+		std::size_t position = 0;
+		for (const RollLayout::Group& group : m_Layout->GetGroups())
+		{
+			if (group.Sides == sides)
+			{
+				return position;
+			}
+			position += static_cast<std::size_t>(group.Rolls);
+		}
+		return position;
+	}
+}
@@ -10,47 +10,95 @@ namespace DiceCalculator::Evaluation
 {
 	void CombinationAstVisitor::Visit(const Expressions::ConstantNode& node)
 	{
-		m_Combinations = { Combination{ node.GetValue(), {} } };
+		m_Stream = std::make_unique<ListCombinationStream>(std::vector<Combination>{ Combination{ node.GetValue(), {} } });
 	}
 
 	void CombinationAstVisitor::Visit(const Expressions::DiceNode& node)
 	{
-		const int rolls = node.GetRolls();
-		const int sides = node.GetSides();
+		if (m_Counting == Counting::Multisets)
+		{
+			m_Stream = std::make_unique<MultisetDiceCombinationStream>(node.GetRolls(), node.GetSides());
+		}
+		else
+		{
+			m_Stream = std::make_unique<DiceCombinationStream>(node.GetRolls(), node.GetSides());
+		}
+	}
 
-		// Start with a single empty outcome to build upon
-		std::vector<Combination> outcomes;
-		outcomes.push_back(Combination{ 0, {} });
+	void CombinationAstVisitor::Visit(const Expressions::OperatorNode& node)
+	{
+		m_Stream = node.GetOperator()->Evaluate(*this, node.GetOperands());
+	}
 
-		for (int r = 0; r < rolls; ++r)
+	std::unique_ptr<CombinationStream> CombinationAstVisitor::TakeStream()
+	{
+		if (!m_Stream)
 		{
-			std::vector<Combination> next;
-			next.reserve(static_cast<size_t>(outcomes.size()) * static_cast<size_t>(sides));
+			throw std::runtime_error("No expression has been visited.");
+		}
+		return std::move(m_Stream);
+	}
 
-			for (const auto& o : outcomes)
-			{
-				for (int face = 1; face <= sides; ++face)
-				{
-					Combination expanded;
-					expanded.TotalValue = o.TotalValue + face;
-					expanded.Rolls = o.Rolls;
-					expanded.Rolls.push_back(Combination::Roll{ sides, face });
-					next.push_back(std::move(expanded));
-					if (next.size() > MaxCombinationsThreshold)
-					{
-						throw std::runtime_error("Combination evaluation exceeded maximum allowed combinations.");
-					}
-				}
-			}
+	std::vector<Combination> CombinationAstVisitor::GetCombinations()
+	{
+		if (!m_Stream)
+		{
+			throw std::runtime_error("No expression has been visited.");
+		}
 
-			outcomes = std::move(next);
+		const std::uint64_t count = m_Stream->Count();
+		if (count > static_cast<std::uint64_t>(MaxCombinationsThreshold))
+		{
+			throw std::runtime_error("Combination evaluation exceeded maximum allowed combinations.");
 		}
 
-		m_Combinations = std::move(outcomes);
+		m_Stream->Reset();
+		std::vector<Combination> combinations;
+		combinations.reserve(static_cast<std::size_t>(count));
+		Combination combination;
+		while (m_Stream->Next(combination))
+		{
+			combinations.push_back(combination);
+		}
+		return combinations;
 	}
 
-	void CombinationAstVisitor::Visit(const Expressions::OperatorNode& node)
+	Distribution CombinationAstVisitor::GetDistribution() const
 	{
-		m_Combinations = node.GetOperator()->Evaluate(*this, node.GetOperands());
+		if (!m_Stream)
+		{
+			throw std::runtime_error("No expression has been visited.");
+		}
+		if (m_Stream->Count() > m_MaxStreamedCombinations)
+		{
+			throw std::runtime_error("Combination evaluation exceeded maximum allowed combinations.");
+		}
+
+		if (!m_ThreadPool)
+		{
+			return Distribution::FromCombinations(*m_Stream);
+		}
+
+		auto shards = m_Stream->Partition(m_ThreadPool->GetThreadCount() * ShardsPerThread);
+		std::vector<Distribution> counts(shards.size());
+		m_ThreadPool->ForEach(shards.size(), [&](std::size_t i)
+			{
+				Combination combination;
+				while (shards[i]->Next(combination))
+				{
+					counts[i].AddOutcome(combination.TotalValue, combination.Weight);
+				}
+			});
+
+		Distribution result;
+		for (const auto& shardCounts : counts)
+		{
+			for (const auto& [value, count] : shardCounts)
+			{
+				result.AddOutcome(value, count);
+			}
+		}
+		result.Normalize();
+		return result;
 	}
-}
\ No newline at end of file
+}
@@ -0,0 +1,458 @@
+#include "DiceCalculator/Evaluation/CombinationStream.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace DiceCalculator::Evaluation
+{
+	namespace
+	{
+		// Layout of the rolls of one dice node; dice that roll nothing have an empty one.
+		const Combination::RollLayout* GetDiceLayout(int rolls, int sides, bool sorted)
+		{
+			if (rolls <= 0 || sides < 1)
+			{
+				return nullptr;
+			}
+			return &Combination::RollLayout::Get({ Combination::RollLayout::Group{ rolls, sides, sorted } });
+		}
+
+		// Number of combinations of a dice stream: one empty combination without dice, none for dice
+		// without sides.
+		std::uint64_t CountDiceCombinations(const Combination::RollLayout* layout, int rolls)
+		{
+			if (layout != nullptr)
+			{
+				return layout->GetCount();
+			}
+			return rolls <= 0 ? 1 : 0;
+		}
+
+		// Faces of the roll list with index `index`.
+		void DecodeFaces(const Combination::RollLayout* layout, std::uint64_t index, std::vector<int>& faces)
+		{
+			for (std::size_t i = 0; i < faces.size(); ++i)
+			{
+				faces[i] = layout->Decode(index, i).Value;
+			}
+		}
+
+		// Splits the indices [first, end) into at most `count` contiguous ranges of equal length, give or
+		// take one. Every index stands for one step of enumeration, so the ranges take the same work.
+		std::vector<std::pair<std::uint64_t, std::uint64_t>> SplitIndices(std::uint64_t first, std::uint64_t end, std::size_t count)
+		{
+			const std::uint64_t size = end - first;
+			const std::uint64_t ranges = std::max<std::uint64_t>(1, std::min<std::uint64_t>(count, size));
+			const std::uint64_t length = size / ranges;
+			const std::uint64_t longer = size % ranges;
+
+			std::vector<std::pair<std::uint64_t, std::uint64_t>> result;
+			result.reserve(static_cast<std::size_t>(ranges));
+			std::uint64_t begin = first;
+			for (std::uint64_t i = 0; i < ranges; ++i)
+			{
+				const std::uint64_t rangeEnd = begin + length + (i < longer ? 1 : 0);
+				result.emplace_back(begin, rangeEnd);
+				begin = rangeEnd;
+			}
+			return result;
+		}
+	}
+
+	std::vector<std::unique_ptr<CombinationStream>> CombinationStream::Partition(std::size_t) const
+	{
+		std::vector<std::unique_ptr<CombinationStream>> shards;
+		shards.push_back(Clone());
+		return shards;
+	}
+
+	ListCombinationStream::ListCombinationStream(std::vector<Combination> combinations) :
+		m_Combinations(std::move(combinations))
+	{
+	}
+
+	bool ListCombinationStream::Next(Combination& out)
+	{
+		if (m_Position >= m_Combinations.size())
+		{
+			return false;
+		}
+
+		const Combination& current = m_Combinations[m_Position++];
+		out.TotalValue = current.TotalValue;
+		out.Rolls = current.Rolls;
+		out.Weight = current.Weight;
+		return true;
+	}
+
+	void ListCombinationStream::Reset()
+	{
+		m_Position = 0;
+	}
+
+	std::unique_ptr<CombinationStream> ListCombinationStream::Clone() const
+	{
+		return std::make_unique<ListCombinationStream>(m_Combinations);
+	}
+
+	std::uint64_t ListCombinationStream::Count() const
+	{
+		return m_Combinations.size();
+	}
+
+	std::vector<std::unique_ptr<CombinationStream>> ListCombinationStream::Partition(std::size_t count) const
+	{
+		std::vector<std::unique_ptr<CombinationStream>> shards;
+		const std::size_t shardCount = std::max<std::size_t>(1, std::min(count, m_Combinations.size()));
+		for (std::size_t i = 0; i < shardCount; ++i)
+		{
+			const std::size_t begin = m_Combinations.size() * i / shardCount;
+			const std::size_t end = m_Combinations.size() * (i + 1) / shardCount;
+			shards.push_back(std::make_unique<ListCombinationStream>(
+				std::vector<Combination>(m_Combinations.begin() + static_cast<std::ptrdiff_t>(begin), m_Combinations.begin() + static_cast<std::ptrdiff_t>(end))));
+		}
+		return shards;
+	}
+
+	DiceCombinationStream::DiceCombinationStream(int rolls, int sides) :
+		DiceCombinationStream(rolls, sides, 0, CountDiceCombinations(GetDiceLayout(rolls, sides, false), rolls))
+	{
+	}
+
+	DiceCombinationStream::DiceCombinationStream(int rolls, int sides, std::uint64_t firstIndex, std::uint64_t endIndex) :
+		m_Rolls(rolls), m_Sides(sides), m_Layout(GetDiceLayout(rolls, sides, false)), m_FirstIndex(firstIndex), m_EndIndex(endIndex),
+		m_Faces(static_cast<std::size_t>(std::max(0, rolls)), 1)
+	{
+		Reset();
+	}
+
+	bool DiceCombinationStream::Next(Combination& out)
+	{
+		if (m_Index >= m_EndIndex)
+		{
+			return false;
+		}
+
+		if (m_Index == m_FirstIndex)
+		{
+			DecodeFaces(m_Layout, m_Index, m_Faces);
+		}
+		else
+		{
+			// Odometer step: the last die turns fastest and carries into the ones before it. The index
+			// bound ends the stream before the first die could overflow.
+			std::size_t position = m_Faces.size();
+			while (position > 0 && ++m_Faces[position - 1] > m_Sides)
+			{
+				m_Faces[--position] = 1;
+			}
+		}
+
+		out.TotalValue = 0;
+		for (const int face : m_Faces)
+		{
+			out.TotalValue += face;
+		}
+		out.Rolls = m_Layout ? Combination::RollList(*m_Layout, m_Index) : Combination::RollList();
+		out.Weight = 1.0;
+		++m_Index;
+		return true;
+	}
+
+	void DiceCombinationStream::Reset()
+	{
+		m_Index = m_FirstIndex;
+	}
+
+	std::unique_ptr<CombinationStream> DiceCombinationStream::Clone() const
+	{
+		return std::make_unique<DiceCombinationStream>(m_Rolls, m_Sides, m_FirstIndex, m_EndIndex);
+	}
+
+	std::uint64_t DiceCombinationStream::Count() const
+	{
+		return m_EndIndex - m_FirstIndex;
+	}
+
+	std::vector<std::unique_ptr<CombinationStream>> DiceCombinationStream::Partition(std::size_t count) const
+	{
+		std::vector<std::unique_ptr<CombinationStream>> shards;
+		for (const auto& [first, end] : SplitIndices(m_FirstIndex, m_EndIndex, count))
+		{
+			shards.push_back(std::make_unique<DiceCombinationStream>(m_Rolls, m_Sides, first, end));
+		}
+		return shards;
+	}
+
+	MultisetDiceCombinationStream::MultisetDiceCombinationStream(int rolls, int sides) :
+		MultisetDiceCombinationStream(rolls, sides, 0, CountDiceCombinations(GetDiceLayout(rolls, sides, true), rolls))
+	{
+	}
+
+	MultisetDiceCombinationStream::MultisetDiceCombinationStream(int rolls, int sides, std::uint64_t firstIndex, std::uint64_t endIndex) :
+		m_Rolls(rolls), m_Sides(sides), m_Layout(GetDiceLayout(rolls, sides, true)), m_FirstIndex(firstIndex), m_EndIndex(endIndex),
+		m_Faces(static_cast<std::size_t>(std::max(0, rolls)), 1)
+	{
+		Reset();
+	}
+
+	bool MultisetDiceCombinationStream::Next(Combination& out)
+	{
+		if (m_Index >= m_EndIndex)
+		{
+			return false;
+		}
+
+		if (m_Index == m_FirstIndex)
+		{
+			DecodeFaces(m_Layout, m_Index, m_Faces);
+		}
+		else
+		{
+			// Bump the last face that can still grow and level every face after it to the new value,
+			// which keeps the faces non-decreasing and visits each multiset exactly once, in index order.
+			std::size_t position = m_Faces.size();
+			while (m_Faces[position - 1] == m_Sides)
+			{
+				--position;
+			}
+
+			const int face = ++m_Faces[position - 1];
+			std::fill(m_Faces.begin() + static_cast<std::ptrdiff_t>(position), m_Faces.end(), face);
+		}
+
+		// The weight is the multinomial coefficient N! / (c1! c2! ...) over the run lengths c of equal
+		// faces, built as a product of binomials so intermediate values stay small.
+		out.TotalValue = 0;
+		out.Rolls = m_Layout ? Combination::RollList(*m_Layout, m_Index) : Combination::RollList();
+		out.Weight = 1.0;
+		std::size_t remaining = m_Faces.size();
+		std::size_t runLength = 0;
+		for (std::size_t i = 0; i < m_Faces.size(); ++i)
+		{
+			out.TotalValue += m_Faces[i];
+
+			++runLength;
+			out.Weight = out.Weight * static_cast<double>(remaining - runLength + 1) / static_cast<double>(runLength);
+			if (i + 1 == m_Faces.size() || m_Faces[i + 1] != m_Faces[i])
+			{
+				remaining -= runLength;
+				runLength = 0;
+			}
+		}
+		++m_Index;
+		return true;
+	}
+
+	void MultisetDiceCombinationStream::Reset()
+	{
+		m_Index = m_FirstIndex;
+	}
+
+	std::unique_ptr<CombinationStream> MultisetDiceCombinationStream::Clone() const
+	{
+		return std::make_unique<MultisetDiceCombinationStream>(m_Rolls, m_Sides, m_FirstIndex, m_EndIndex);
+	}
+
+	std::uint64_t MultisetDiceCombinationStream::Count() const
+	{
+		return m_EndIndex - m_FirstIndex;
+	}
+
+	std::vector<std::unique_ptr<CombinationStream>> MultisetDiceCombinationStream::Partition(std::size_t count) const
+	{
+		std::vector<std::unique_ptr<CombinationStream>> shards;
+		for (const auto& [first, end] : SplitIndices(m_FirstIndex, m_EndIndex, count))
+		{
+			shards.push_back(std::make_unique<MultisetDiceCombinationStream>(m_Rolls, m_Sides, first, end));
+		}
+		return shards;
+	}
+
+
+	ProductCombinationStream::ProductCombinationStream(std::vector<std::unique_ptr<CombinationStream>> parts, Combiner combiner, Rolls rolls) :
+		m_Parts(std::move(parts)), m_Current(m_Parts.size()), m_Combiner(std::move(combiner)), m_Rolls(rolls)
+	{
+	}
+
+	bool ProductCombinationStream::Next(Combination& out)
+	{
+		if (m_Exhausted)
+		{
+			return false;
+		}
+
+		if (!m_Started)
+		{
+			m_Started = true;
+			for (std::size_t i = 0; i < m_Parts.size(); ++i)
+			{
+				if (!m_Parts[i]->Next(m_Current[i]))
+				{
+					m_Exhausted = true;
+					return false;
+				}
+			}
+		}
+		else
+		{
+			// Advance the last part; when it runs out, rewind it and carry into the part before.
+			std::size_t position = m_Parts.size();
+			while (true)
+			{
+				if (position == 0)
+				{
+					m_Exhausted = true;
+					return false;
+				}
+				--position;
+
+				if (m_Parts[position]->Next(m_Current[position]))
+				{
+					break;
+				}
+				m_Parts[position]->Reset();
+				m_Parts[position]->Next(m_Current[position]);
+			}
+		}
+
+		m_Combiner(m_Current, out);
+		if (m_Rolls == Rolls::Concatenated)
+		{
+			ConcatenateRolls(out);
+		}
+		out.Weight = 1.0;
+		for (const auto& part : m_Current)
+		{
+			out.Weight *= part.Weight;
+		}
+		return true;
+	}
+
+	void ProductCombinationStream::Reset()
+	{
+		for (auto& part : m_Parts)
+		{
+			part->Reset();
+		}
+		m_Started = false;
+		m_Exhausted = false;
+	}
+
+	std::unique_ptr<CombinationStream> ProductCombinationStream::Clone() const
+	{
+		std::vector<std::unique_ptr<CombinationStream>> parts;
+		parts.reserve(m_Parts.size());
+		for (const auto& part : m_Parts)
+		{
+			parts.push_back(part->Clone());
+		}
+		return std::make_unique<ProductCombinationStream>(std::move(parts), m_Combiner, m_Rolls);
+	}
+
+	std::uint64_t ProductCombinationStream::Count() const
+	{
+		std::uint64_t count = 1;
+		for (const auto& part : m_Parts)
+		{
+			const std::uint64_t partCount = part->Count();
+			if (partCount == 0)
+			{
+				return 0;
+			}
+			count = count > std::numeric_limits<std::uint64_t>::max() / partCount ? std::numeric_limits<std::uint64_t>::max() : count * partCount;
+		}
+		return count;
+	}
+
+	std::vector<std::unique_ptr<CombinationStream>> ProductCombinationStream::Partition(std::size_t count) const
+	{
+		return PartitionFrom(0, count);
+	}
+
+	std::vector<std::unique_ptr<CombinationStream>> ProductCombinationStream::PartitionFrom(std::size_t firstPart, std::size_t count) const
+	{
+		std::vector<std::unique_ptr<CombinationStream>> shards;
+		for (std::size_t i = firstPart; i < m_Parts.size() && count > 1; ++i)
+		{
+			auto partShards = m_Parts[i]->Partition(count);
+			if (partShards.size() < 2)
+			{
+				continue;
+			}
+
+			// Each shard of part i is a product of its own; split those further if there are too few.
+			const std::size_t perShard = (count + partShards.size() - 1) / partShards.size();
+			for (auto& partShard : partShards)
+			{
+				std::vector<std::unique_ptr<CombinationStream>> parts;
+				parts.reserve(m_Parts.size());
+				for (std::size_t j = 0; j < m_Parts.size(); ++j)
+				{
+					parts.push_back(j == i ? std::move(partShard) : m_Parts[j]->Clone());
+				}
+				auto product = std::make_unique<ProductCombinationStream>(std::move(parts), m_Combiner, m_Rolls);
+
+				if (perShard > 1)
+				{
+					for (auto& subShard : product->PartitionFrom(i + 1, perShard))
+					{
+						shards.push_back(std::move(subShard));
+					}
+				}
+				else
+				{
+					shards.push_back(std::move(product));
+				}
+			}
+			return shards;
+		}
+
+		shards.push_back(Clone());
+		return shards;
+	}
+
+	void ProductCombinationStream::ConcatenateRolls(Combination& out)
+	{
+		bool layoutChanged = m_PartLayouts.size() != m_Current.size();
+		for (std::size_t i = 0; i < m_Current.size() && !layoutChanged; ++i)
+		{
+			layoutChanged = m_PartLayouts[i] != m_Current[i].Rolls.GetLayout();
+		}
+
+		if (layoutChanged)
+		{
+			m_PartLayouts.clear();
+			for (const auto& part : m_Current)
+			{
+				m_PartLayouts.push_back(part.Rolls.GetLayout());
+			}
+			const Combination::RollLayout& layout = Combination::RollLayout::Concatenate(m_PartLayouts);
+			m_Layout = layout.GetRollCount() > 0 ? &layout : nullptr;
+
+			// The last part is the least significant digit of the concatenated index.
+			m_PartStrides.assign(m_Current.size(), 1);
+			std::uint64_t stride = 1;
+			for (std::size_t i = m_Current.size(); i > 0; --i)
+			{
+				m_PartStrides[i - 1] = stride;
+				stride *= m_PartLayouts[i - 1] ? m_PartLayouts[i - 1]->GetCount() : 1;
+			}
+		}
+
+		if (m_Layout == nullptr)
+		{
+			out.Rolls = Combination::RollList();
+			return;
+		}
+
+		std::uint64_t index = 0;
+		for (std::size_t i = 0; i < m_Current.size(); ++i)
+		{
+			index += m_Current[i].Rolls.GetIndex() * m_PartStrides[i];
+		}
+		out.Rolls = Combination::RollList(*m_Layout, index);
+	}
+}
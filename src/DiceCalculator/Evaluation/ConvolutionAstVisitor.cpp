@@ -1,13 +1,142 @@
 #pragma once
 
 #include "DiceCalculator/Evaluation/ConvolutionAstVisitor.h"
+#include "DiceCalculator/Evaluation/Convolver.h"
 #include "DiceCalculator/Expressions/DiceNode.h"
 #include "DiceCalculator/Expressions/ConstantNode.h"
 #include "DiceCalculator/Expressions/OperatorNode.h"
 #include <stdexcept>
+#include <utility>
+#include <queue>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace DiceCalculator::Evaluation
 {
+	namespace
+	{
+		// One leaf or partial sum of EvaluateSum. Bare dice stay unevaluated so that combining them with
+		// another term can use the sliding-window kernel.
+		struct SumTerm
+		{
+			Distribution Value;
+			const Expressions::DiceNode* Dice = nullptr;
+			bool Negated = false;
+		};
+
+		Distribution Materialize(const Convolver& convolver, const SumTerm& term)
+		{
+			if (term.Dice == nullptr)
+			{
+				return term.Value;
+			}
+
+			Distribution pool = convolver.UniformDiceSum(term.Dice->GetRolls(), term.Dice->GetSides());
+			return term.Negated ? pool.Negated() : pool;
+		}
+
+		// Nodes reachable from `root` through more than one parent.
+		std::unordered_set<const Expressions::DiceAst*> FindSharedNodes(const Expressions::DiceAst& root)
+		{
+			std::unordered_set<const Expressions::DiceAst*> seen;
+			std::unordered_set<const Expressions::DiceAst*> shared;
+			std::vector<const Expressions::DiceAst*> pending{ &root };
+			seen.insert(&root);
+			while (!pending.empty())
+			{
+				const auto* operatorNode = dynamic_cast<const Expressions::OperatorNode*>(pending.back());
+				pending.pop_back();
+				if (operatorNode == nullptr)
+				{
+					continue;
+				}
+
+				for (const auto& operand : operatorNode->GetOperands())
+				{
+					if (!operand)
+					{
+						continue;
+					}
+					if (seen.insert(operand.get()).second)
+					{
+						pending.push_back(operand.get());
+					}
+					else
+					{
+						shared.insert(operand.get());
+					}
+				}
+			}
+			return shared;
+		}
+
+		// Width of the support of a term, which the cost of convolving with it grows with.
+		std::size_t GetSpan(const SumTerm& term)
+		{
+			if (term.Dice != nullptr)
+			{
+				return static_cast<std::size_t>(term.Dice->GetRolls()) * static_cast<std::size_t>(term.Dice->GetSides() - 1) + 1;
+			}
+			if (term.Value.IsEmpty())
+			{
+				return 0;
+			}
+			const auto [min, max] = term.Value.GetMinMax();
+			return static_cast<std::size_t>(static_cast<long long>(max) - min + 1);
+		}
+
+		// Merge k of the plan combines the nodes Lhs and Rhs into node n + k, where nodes 0..n-1 are the terms.
+		struct MergeStep
+		{
+			std::size_t Lhs;
+			std::size_t Rhs;
+		};
+
+		// Huffman order: always merge the two narrowest nodes, so wide partial sums are convolved as few
+		// times as possible. Ties go to the lower node id, so the plan depends only on the spans.
+		std::vector<MergeStep> PlanMerges(const std::vector<SumTerm>& terms)
+		{
+			using Node = std::pair<std::size_t, std::size_t>;
+			std::priority_queue<Node, std::vector<Node>, std::greater<Node>> queue;
+			for (std::size_t i = 0; i < terms.size(); ++i)
+			{
+				queue.emplace(GetSpan(terms[i]), i);
+			}
+
+			std::vector<MergeStep> plan;
+			plan.reserve(terms.size() - 1);
+			while (queue.size() > 1)
+			{
+				const auto [lhsSpan, lhs] = queue.top();
+				queue.pop();
+				const auto [rhsSpan, rhs] = queue.top();
+				queue.pop();
+
+				plan.push_back(MergeStep{ lhs, rhs });
+				const std::size_t span = lhsSpan == 0 || rhsSpan == 0 ? 0 : lhsSpan + rhsSpan - 1;
+				queue.emplace(span, terms.size() + plan.size() - 1);
+			}
+			return plan;
+		}
+
+		SumTerm Combine(const Convolver& convolver, const SumTerm& lhs, const SumTerm& rhs)
+		{
+			const SumTerm* dice = rhs.Dice != nullptr ? &rhs : (lhs.Dice != nullptr ? &lhs : nullptr);
+			if (dice == nullptr)
+			{
+				return SumTerm{ convolver.Add(lhs.Value, rhs.Value) };
+			}
+
+			const Distribution other = Materialize(convolver, dice == &rhs ? lhs : rhs);
+			const int rolls = dice->Dice->GetRolls();
+			const int sides = dice->Dice->GetSides();
+			return SumTerm{ dice->Negated ? convolver.SubtractDice(other, rolls, sides) : convolver.AddDice(other, rolls, sides) };
+		}
+	}
+
 	void ConvolutionAstVisitor::Visit(const Expressions::ConstantNode& node)
 	{
 		m_Distribution = { {node.GetValue(), 1.0} };
@@ -25,48 +154,193 @@ namespace DiceCalculator::Evaluation
 			return;
 		}
 
-		// Single die distribution
-		Distribution singleDie;
 		if (sides <= 0)
 		{
 			throw std::runtime_error("DiceNode has non-positive sides");
 		}
-		else
+
+		m_Distribution = EvaluateNode(node, [&]() { return m_Convolver.UniformDiceSum(rolls, sides); });
+	}
+
+	void ConvolutionAstVisitor::Visit(const Expressions::OperatorNode& node)
+	{
+		m_Distribution = EvaluateNode(node, [&]() { return node.GetOperator()->Evaluate(*this, node.GetOperands()); });
+	}
+
+	struct ConvolutionAstVisitor::EvaluationState
+	{
+		// Nodes with more than one parent in the evaluated DAG; only these are memoized.
+		std::unordered_set<const Expressions::DiceAst*> SharedNodes;
+
+		std::mutex Mutex;
+		std::unordered_map<const Expressions::DiceAst*, std::shared_future<Distribution>> Results;
+	};
+
+	Distribution ConvolutionAstVisitor::EvaluateNode(const Expressions::DiceAst& node, const std::function<Distribution()>& compute)
+	{
+		// The visitor that starts an evaluation owns its state; nested Accept calls and child visitors reuse it.
+		const bool isRoot = !m_Evaluation;
+		if (isRoot)
+		{
+			m_Evaluation = std::make_shared<EvaluationState>();
+			m_Evaluation->SharedNodes = FindSharedNodes(node);
+		}
+		struct ResetOnExit
 		{
-			double faceProb = 1.0 / static_cast<double>(sides);
-			for (int face = 1; face <= sides; ++face)
+			std::shared_ptr<EvaluationState>& State;
+			bool Active;
+			~ResetOnExit() { if (Active) State.reset(); }
+		} reset{ m_Evaluation, isRoot };
+
+		auto computeWithCache = [&]()
 			{
-				singleDie.AddOutcome(face, faceProb);
+				if (m_Cache)
+				{
+					if (auto cached = m_Cache->Find(node))
+					{
+						return *cached;
+					}
+				}
+
+				Distribution result = compute();
+				if (m_Cache)
+				{
+					m_Cache->Insert(node, result);
+				}
+				return result;
+			};
+
+		if (!m_Evaluation->SharedNodes.contains(&node))
+		{
+			return computeWithCache();
+		}
+
+		// The first visitor to reach a shared node computes it; any other (possibly concurrent) visit waits for that result.
+		std::promise<Distribution> promise;
+		std::shared_future<Distribution> earlier;
+		{
+			std::lock_guard lock(m_Evaluation->Mutex);
+			auto [it, inserted] = m_Evaluation->Results.try_emplace(&node);
+			if (inserted)
+			{
+				it->second = promise.get_future().share();
+			}
+			else
+			{
+				earlier = it->second;
 			}
 		}
+		if (earlier.valid())
+		{
+			return earlier.get();
+		}
+
+		try
+		{
+			Distribution result = computeWithCache();
+			promise.set_value(result);
+			return result;
+		}
+		catch (...)
+		{
+			promise.set_exception(std::current_exception());
+			throw;
+		}
+	}
+
+	ConvolutionAstVisitor ConvolutionAstVisitor::CreateChild() const
+	{
+		ConvolutionAstVisitor child(m_Convolver, m_ThreadPool, m_Cache);
+		child.m_Evaluation = m_Evaluation;
+		return child;
+	}
 
-		// Start with one die, then convolve `rolls` times
-		m_Distribution = singleDie;
-		for (int i = 1; i < rolls; ++i)
+	std::vector<Distribution> ConvolutionAstVisitor::EvaluateOperands(std::span<const std::shared_ptr<Expressions::DiceAst>> operands) const
+	{
+		std::vector<Distribution> results(operands.size());
+		ForEach(operands.size(), [&](std::size_t i)
+			{
+				ConvolutionAstVisitor visitor = CreateChild();
+				operands[i]->Accept(visitor);
+				results[i] = visitor.GetDistribution();
+			});
+		return results;
+	}
+
+	Distribution ConvolutionAstVisitor::EvaluateSum(
+		std::span<const std::shared_ptr<Expressions::DiceAst>> positive,
+		std::span<const std::shared_ptr<Expressions::DiceAst>> negative) const
+	{
+		// Constants only shift the sum, so they are added up instead of convolved as point masses.
+		int shift = 0;
+		std::vector<std::pair<const Expressions::DiceAst*, bool>> operands;
+		operands.reserve(positive.size() + negative.size());
+		for (std::size_t i = 0; i < positive.size() + negative.size(); ++i)
+		{
+			const bool negated = i >= positive.size();
+			const Expressions::DiceAst& operand = negated ? *negative[i - positive.size()] : *positive[i];
+			if (auto constant = dynamic_cast<const Expressions::ConstantNode*>(&operand))
+			{
+				shift += negated ? -constant->GetValue() : constant->GetValue();
+				continue;
+			}
+			operands.emplace_back(&operand, negated);
+		}
+		if (operands.empty())
 		{
-			Distribution next;
-			// Reserve approximate size: current distinct sums * sides
-			next.Reserve(m_Distribution.Size() * (sides > 0 ? static_cast<size_t>(sides) : 1));
+			return Distribution{ {shift, 1.0} };
+		}
 
-			for (auto const& pair : m_Distribution)
+		std::vector<SumTerm> terms(operands.size());
+		ForEach(operands.size(), [&](std::size_t i)
 			{
-				int baseValue = pair.first;
-				double baseProb = pair.second;
-				// convolve with single die outcomes
-				for (auto const& facePair : singleDie)
+				SumTerm& term = terms[i];
+				term.Negated = operands[i].second;
+				const Expressions::DiceAst& operand = *operands[i].first;
+
+				auto dice = dynamic_cast<const Expressions::DiceNode*>(&operand);
+				if (dice && dice->GetRolls() > 0 && dice->GetSides() > 0)
 				{
-					int newValue = baseValue + facePair.first;
-					double newProb = baseProb * facePair.second;
-					next.AddOutcome(newValue, newProb);
+					term.Dice = dice;
+					return;
 				}
-			}
 
-			m_Distribution = std::move(next);
-		}
+				ConvolutionAstVisitor visitor = CreateChild();
+				operand.Accept(visitor);
+				term.Value = term.Negated ? visitor.GetDistribution().Negated() : visitor.GetDistribution();
+			});
+
+		// Execute the merge plan; the two inputs of every merge are independent and evaluated concurrently.
+		const std::vector<MergeStep> plan = PlanMerges(terms);
+		std::function<SumTerm(std::size_t)> evaluate = [&](std::size_t id)
+			{
+				if (id < terms.size())
+				{
+					return std::move(terms[id]);
+				}
+
+				const MergeStep& step = plan[id - terms.size()];
+				SumTerm inputs[2];
+				ForEach(2, [&](std::size_t i) { inputs[i] = evaluate(i == 0 ? step.Lhs : step.Rhs); });
+				return Combine(m_Convolver, inputs[0], inputs[1]);
+			};
+
+		Distribution result = Materialize(m_Convolver, evaluate(terms.size() + plan.size() - 1));
+		result.Shift(shift);
+		return result;
 	}
 
-	void ConvolutionAstVisitor::Visit(const Expressions::OperatorNode& node)
+	void ConvolutionAstVisitor::ForEach(std::size_t count, const std::function<void(std::size_t)>& body) const
 	{
-		m_Distribution = node.GetOperator()->Evaluate(*this, node.GetOperands());
+		if (m_ThreadPool && count > 1)
+		{
+			m_ThreadPool->ForEach(count, body);
+			return;
+		}
+
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			body(i);
+		}
 	}
 }
\ No newline at end of file
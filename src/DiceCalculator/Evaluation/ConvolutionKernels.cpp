@@ -0,0 +1,256 @@
+#include "DiceCalculator/Evaluation/ConvolutionKernels.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define DICECALCULATOR_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// MSVC accepts any intrinsic in any function; GCC and Clang need the instruction set enabled per function
+// so that the rest of the library keeps the baseline target.
+#if defined(__GNUC__) || defined(__clang__)
+#define DICECALCULATOR_TARGET(features) __attribute__((target(features)))
+#else
+#define DICECALCULATOR_TARGET(features)
+#endif
+
+namespace DiceCalculator::Evaluation
+{
+	namespace
+	{
+		void ConvolveScalar(const double* lhs, std::size_t lhsSize, const double* rhs, std::size_t rhsSize, double* result)
+		{
+			for (std::size_t i = 0; i < lhsSize; ++i)
+			{
+				const double lhsProb = lhs[i];
+				if (lhsProb == 0.0)
+				{
+					continue;
+				}
+
+				double* row = result + i;
+				for (std::size_t j = 0; j < rhsSize; ++j)
+				{
+					row[j] += lhsProb * rhs[j];
+				}
+			}
+		}
+
+#if defined(DICECALCULATOR_X86)
+		// The vector kernels keep the row-wise multiply-accumulate of the scalar kernel, two registers
+		// per iteration, and finish each row with scalar code.
+
+		DICECALCULATOR_TARGET("sse2")
+		void ConvolveSse2(const double* lhs, std::size_t lhsSize, const double* rhs, std::size_t rhsSize, double* result)
+		{
+			for (std::size_t i = 0; i < lhsSize; ++i)
+			{
+				const double lhsProb = lhs[i];
+				if (lhsProb == 0.0)
+				{
+					continue;
+				}
+
+				const __m128d factor = _mm_set1_pd(lhsProb);
+				double* row = result + i;
+				std::size_t j = 0;
+				for (; j + 4 <= rhsSize; j += 4)
+				{
+					const __m128d r0 = _mm_add_pd(_mm_loadu_pd(row + j), _mm_mul_pd(factor, _mm_loadu_pd(rhs + j)));
+					const __m128d r1 = _mm_add_pd(_mm_loadu_pd(row + j + 2), _mm_mul_pd(factor, _mm_loadu_pd(rhs + j + 2)));
+					_mm_storeu_pd(row + j, r0);
+					_mm_storeu_pd(row + j + 2, r1);
+				}
+				for (; j < rhsSize; ++j)
+				{
+					row[j] += lhsProb * rhs[j];
+				}
+			}
+		}
+
+		DICECALCULATOR_TARGET("avx2,fma")
+		void ConvolveAvx2(const double* lhs, std::size_t lhsSize, const double* rhs, std::size_t rhsSize, double* result)
+		{
+			for (std::size_t i = 0; i < lhsSize; ++i)
+			{
+				const double lhsProb = lhs[i];
+				if (lhsProb == 0.0)
+				{
+					continue;
+				}
+
+				const __m256d factor = _mm256_set1_pd(lhsProb);
+				double* row = result + i;
+				std::size_t j = 0;
+				for (; j + 8 <= rhsSize; j += 8)
+				{
+					const __m256d r0 = _mm256_fmadd_pd(factor, _mm256_loadu_pd(rhs + j), _mm256_loadu_pd(row + j));
+					const __m256d r1 = _mm256_fmadd_pd(factor, _mm256_loadu_pd(rhs + j + 4), _mm256_loadu_pd(row + j + 4));
+					_mm256_storeu_pd(row + j, r0);
+					_mm256_storeu_pd(row + j + 4, r1);
+				}
+				for (; j < rhsSize; ++j)
+				{
+					row[j] += lhsProb * rhs[j];
+				}
+			}
+		}
+
+		DICECALCULATOR_TARGET("avx512f")
+		void ConvolveAvx512(const double* lhs, std::size_t lhsSize, const double* rhs, std::size_t rhsSize, double* result)
+		{
+			for (std::size_t i = 0; i < lhsSize; ++i)
+			{
+				const double lhsProb = lhs[i];
+				if (lhsProb == 0.0)
+				{
+					continue;
+				}
+
+				const __m512d factor = _mm512_set1_pd(lhsProb);
+				double* row = result + i;
+				std::size_t j = 0;
+				for (; j + 16 <= rhsSize; j += 16)
+				{
+					const __m512d r0 = _mm512_fmadd_pd(factor, _mm512_loadu_pd(rhs + j), _mm512_loadu_pd(row + j));
+					const __m512d r1 = _mm512_fmadd_pd(factor, _mm512_loadu_pd(rhs + j + 8), _mm512_loadu_pd(row + j + 8));
+					_mm512_storeu_pd(row + j, r0);
+					_mm512_storeu_pd(row + j + 8, r1);
+				}
+				for (; j < rhsSize; ++j)
+				{
+					row[j] += lhsProb * rhs[j];
+				}
+			}
+		}
+
+		struct CpuFeatures
+		{
+			bool Sse2 = false;
+			bool Avx2 = false;
+			bool Avx512 = false;
+		};
+
+		CpuFeatures DetectCpuFeatures()
+		{
+			CpuFeatures features;
+#if defined(_MSC_VER)
+			int info[4];
+			__cpuid(info, 0);
+			const int maxLeaf = info[0];
+
+			__cpuid(info, 1);
+			features.Sse2 = (info[3] & (1 << 26)) != 0;
+			const bool fma = (info[2] & (1 << 12)) != 0;
+			const bool osxsave = (info[2] & (1 << 27)) != 0;
+			const bool avx = (info[2] & (1 << 28)) != 0;
+			if (!osxsave || !avx || maxLeaf < 7)
+			{
+				return features;
+			}
+
+			// The OS must save the YMM (and for AVX-512 also the opmask and ZMM) state on context switches.
+			const unsigned long long xcr0 = _xgetbv(0);
+			const bool ymmEnabled = (xcr0 & 0x6) == 0x6;
+			const bool zmmEnabled = (xcr0 & 0xE6) == 0xE6;
+
+			__cpuidex(info, 7, 0);
+			features.Avx2 = ymmEnabled && fma && (info[1] & (1 << 5)) != 0;
+			features.Avx512 = zmmEnabled && (info[1] & (1 << 16)) != 0;
+#else
+			__builtin_cpu_init();
+			features.Sse2 = __builtin_cpu_supports("sse2");
+			features.Avx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+			features.Avx512 = __builtin_cpu_supports("avx512f");
+#endif
+			return features;
+		}
+#endif
+	}
+
+	bool ConvolutionKernels::IsSupported(InstructionSet instructionSet)
+	{
+		if (instructionSet == InstructionSet::Scalar)
+		{
+			return true;
+		}
+
+#if defined(DICECALCULATOR_X86)
+		static const CpuFeatures features = DetectCpuFeatures();
+		switch (instructionSet)
+		{
+		case InstructionSet::Sse2:
+			return features.Sse2;
+		case InstructionSet::Avx2:
+			return features.Avx2;
+		case InstructionSet::Avx512:
+			return features.Avx512;
+		default:
+			return false;
+		}
+#else
+		return false;
+#endif
+	}
+
+	ConvolutionKernels::InstructionSet ConvolutionKernels::GetBestSupported()
+	{
+		for (InstructionSet instructionSet : { InstructionSet::Avx512, InstructionSet::Avx2, InstructionSet::Sse2 })
+		{
+			if (IsSupported(instructionSet))
+			{
+				return instructionSet;
+			}
+		}
+		return InstructionSet::Scalar;
+	}
+
+	std::string_view ConvolutionKernels::GetName(InstructionSet instructionSet)
+	{
+		switch (instructionSet)
+		{
+		case InstructionSet::Scalar:
+			return "Scalar";
+		case InstructionSet::Sse2:
+			return "SSE2";
+		case InstructionSet::Avx2:
+			return "AVX2";
+		case InstructionSet::Avx512:
+			return "AVX-512";
+		default:
+			return "Unknown";
+		}
+	}
+
+	ConvolutionKernels::DirectKernel ConvolutionKernels::GetDirectKernel(InstructionSet instructionSet)
+	{
+		if (!IsSupported(instructionSet))
+		{
+			return nullptr;
+		}
+
+		switch (instructionSet)
+		{
+		case InstructionSet::Scalar:
+			return &ConvolveScalar;
+#if defined(DICECALCULATOR_X86)
+		case InstructionSet::Sse2:
+			return &ConvolveSse2;
+		case InstructionSet::Avx2:
+			return &ConvolveAvx2;
+		case InstructionSet::Avx512:
+			return &ConvolveAvx512;
+#endif
+		default:
+			return nullptr;
+		}
+	}
+
+	void ConvolutionKernels::ConvolveDirect(const double* lhs, std::size_t lhsSize, const double* rhs, std::size_t rhsSize, double* result)
+	{
+		static const DirectKernel kernel = GetDirectKernel(GetBestSupported());
+		kernel(lhs, lhsSize, rhs, rhsSize, result);
+	}
+}
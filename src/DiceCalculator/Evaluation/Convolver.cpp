@@ -0,0 +1,679 @@
+#include "DiceCalculator/Evaluation/Convolver.h"
+#include "DiceCalculator/Evaluation/ConvolutionKernels.h"
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <complex>
+#include <cmath>
+#include <numbers>
+#include <limits>
+#include <stdexcept>
+#include <cstdint>
+
+namespace DiceCalculator::Evaluation
+{
+	namespace
+	{
+		using Complex = std::complex<double>;
+
+		// In-place iterative radix-2 FFT. `values.size()` must be a power of two.
+		void Fft(std::vector<Complex>& values, bool inverse)
+		{
+			const std::size_t n = values.size();
+
+			for (std::size_t i = 1, j = 0; i < n; ++i)
+			{
+				std::size_t bit = n >> 1;
+				for (; j & bit; bit >>= 1)
+				{
+					j ^= bit;
+				}
+				j ^= bit;
+				if (i < j)
+				{
+					std::swap(values[i], values[j]);
+				}
+			}
+
+			// Twiddles are computed directly rather than by repeated multiplication to keep the
+			// round-off independent of the transform length.
+			std::vector<Complex> twiddles(n / 2);
+			const double sign = inverse ? 1.0 : -1.0;
+			for (std::size_t k = 0; k < n / 2; ++k)
+			{
+				const double angle = sign * 2.0 * std::numbers::pi * static_cast<double>(k) / static_cast<double>(n);
+				twiddles[k] = Complex(std::cos(angle), std::sin(angle));
+			}
+
+			for (std::size_t length = 2; length <= n; length <<= 1)
+			{
+				const std::size_t half = length / 2;
+				const std::size_t stride = n / length;
+				for (std::size_t start = 0; start < n; start += length)
+				{
+					for (std::size_t k = 0; k < half; ++k)
+					{
+						const Complex even = values[start + k];
+						const Complex odd = values[start + k + half] * twiddles[k * stride];
+						values[start + k] = even + odd;
+						values[start + k + half] = even - odd;
+					}
+				}
+			}
+
+			if (inverse)
+			{
+				for (auto& value : values)
+				{
+					value /= static_cast<double>(n);
+				}
+			}
+		}
+
+		// FFT results are kept only where they exceed their round-off bound by this factor, i.e. where
+		// they are accurate to about nine significant digits.
+		constexpr double TrustedFftMagnitude = 1u << 30;
+
+		double Norm2(const double* values, std::size_t size)
+		{
+			double sum = 0.0;
+			for (std::size_t i = 0; i < size; ++i)
+			{
+				sum += values[i] * values[i];
+			}
+			return std::sqrt(sum);
+		}
+
+		// The run of non-zero slots of a dense operand, and whether it is log-concave: contiguous, with
+		// v[i] / v[i - 1] >= v[i + 1] / v[i]. Dice pools, keep-highest rolls and their sums all are.
+		struct NonZeroRun
+		{
+			bool Empty = true;
+			bool LogConcave = false;
+			std::size_t First = 0;
+			std::size_t Last = 0;
+		};
+
+		NonZeroRun FindNonZeroRun(const double* values, std::size_t size)
+		{
+			NonZeroRun run;
+			while (run.First < size && values[run.First] == 0.0)
+			{
+				++run.First;
+			}
+			if (run.First == size)
+			{
+				return run;
+			}
+
+			run.Empty = false;
+			run.Last = size - 1;
+			while (values[run.Last] == 0.0)
+			{
+				--run.Last;
+			}
+
+			// The slack absorbs the round-off of runs that are exactly log-linear, such as a single die.
+			// Subnormal values at the far ends have too few digits to compare; products with them stay
+			// below the significance threshold of SumSlot unless the whole slot is subnormal, and such
+			// slots are summed in full.
+			const double smallest = std::numeric_limits<double>::min();
+			run.LogConcave = true;
+			for (std::size_t i = run.First + 1; i < run.Last && run.LogConcave; ++i)
+			{
+				run.LogConcave = values[i] > 0.0 && (values[i - 1] < smallest || values[i + 1] < smallest
+					|| values[i] / values[i - 1] >= values[i + 1] / values[i] * (1.0 - 1e-12));
+			}
+			return run;
+		}
+
+		// Sums lhs[j] * rhs[k - j] for j in [first, last], in four chains that the compiler can overlap.
+		double SumProducts(const double* lhs, const double* rhs, std::size_t k, std::size_t first, std::size_t last)
+		{
+			double sums[4] = {};
+			std::size_t j = first;
+			for (; j + 3 <= last; j += 4)
+			{
+				sums[0] += lhs[j] * rhs[k - j];
+				sums[1] += lhs[j + 1] * rhs[k - j - 1];
+				sums[2] += lhs[j + 2] * rhs[k - j - 2];
+				sums[3] += lhs[j + 3] * rhs[k - j - 3];
+			}
+			for (; j <= last; ++j)
+			{
+				sums[0] += lhs[j] * rhs[k - j];
+			}
+			return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+		}
+
+		// Returns lhs[j] * rhs[k - j] summed over all j, as a sum of non-negative terms that is accurate
+		// to a few ulps. For log-concave operands the terms rise to a single peak and fall on both sides,
+		// so only the terms within eps / count of the peak are summed: the count - 1 others together
+		// stay below eps * peak. In the far tails that leaves a small fraction of the overlap.
+		double SumSlot(const double* lhs, const NonZeroRun& lhsRun, const double* rhs, const NonZeroRun& rhsRun, std::size_t k)
+		{
+			if (lhsRun.Empty || rhsRun.Empty || k < lhsRun.First + rhsRun.First || k > lhsRun.Last + rhsRun.Last)
+			{
+				return 0.0;
+			}
+
+			std::size_t first = std::max(lhsRun.First, k > rhsRun.Last ? k - rhsRun.Last : 0);
+			std::size_t last = std::min(lhsRun.Last, k - rhsRun.First);
+			if (!lhsRun.LogConcave || !rhsRun.LogConcave)
+			{
+				return SumProducts(lhs, rhs, k, first, last);
+			}
+
+			// The peak is the first term whose successor is smaller. lhs[j + 1] / lhs[j] falls and
+			// rhs[k - j] / rhs[k - j - 1] rises with j, so it can be found by bisection.
+			std::size_t peak = first;
+			std::size_t high = last;
+			while (peak < high)
+			{
+				const std::size_t mid = peak + (high - peak) / 2;
+				if (lhs[mid + 1] / lhs[mid] < rhs[k - mid] / rhs[k - mid - 1])
+				{
+					high = mid;
+				}
+				else
+				{
+					peak = mid + 1;
+				}
+			}
+
+			const double threshold = lhs[peak] * rhs[k - peak] * std::numeric_limits<double>::epsilon()
+				/ static_cast<double>(last - first + 1);
+			const auto significant = [&](std::size_t j) { return lhs[j] * rhs[k - j] >= threshold; };
+
+			// The terms fall monotonically away from the peak, so both ends of the significant range
+			// are found by bisection as well.
+			std::size_t low = first;
+			high = peak;
+			while (low < high)
+			{
+				const std::size_t mid = low + (high - low) / 2;
+				if (significant(mid))
+				{
+					high = mid;
+				}
+				else
+				{
+					low = mid + 1;
+				}
+			}
+			first = low;
+
+			low = peak;
+			high = last;
+			while (low < high)
+			{
+				const std::size_t mid = high - (high - low) / 2;
+				if (significant(mid))
+				{
+					low = mid;
+				}
+				else
+				{
+					high = mid - 1;
+				}
+			}
+			last = high;
+
+			return SumProducts(lhs, rhs, k, first, last);
+		}
+
+		// Minimal arbitrary-precision unsigned integer, just enough for exact dice counts. Limbs are
+		// 32 bits wide so that every intermediate product fits in 64 bits on all compilers.
+		using Limbs = std::vector<std::uint32_t>;
+
+		void Trim(Limbs& value)
+		{
+			while (!value.empty() && value.back() == 0)
+			{
+				value.pop_back();
+			}
+		}
+
+		// value += addend * factor
+		void MultiplyAdd(Limbs& value, const Limbs& addend, std::uint32_t factor)
+		{
+			if (factor == 0 || addend.empty())
+			{
+				return;
+			}
+			if (value.size() < addend.size() + 1)
+			{
+				value.resize(addend.size() + 1, 0);
+			}
+
+			std::uint64_t carry = 0;
+			std::size_t i = 0;
+			for (; i < addend.size(); ++i)
+			{
+				const std::uint64_t t = static_cast<std::uint64_t>(addend[i]) * factor + value[i] + carry;
+				value[i] = static_cast<std::uint32_t>(t);
+				carry = t >> 32;
+			}
+			for (; carry != 0; ++i)
+			{
+				if (i == value.size())
+				{
+					value.push_back(0);
+				}
+				const std::uint64_t t = static_cast<std::uint64_t>(value[i]) + carry;
+				value[i] = static_cast<std::uint32_t>(t);
+				carry = t >> 32;
+			}
+			Trim(value);
+		}
+
+		// value -= subtrahend * factor; the result must not be negative.
+		void MultiplySubtract(Limbs& value, const Limbs& subtrahend, std::uint32_t factor)
+		{
+			if (factor == 0 || subtrahend.empty())
+			{
+				return;
+			}
+
+			std::uint64_t carry = 0;
+			for (std::size_t i = 0; i < value.size() && (i < subtrahend.size() || carry != 0); ++i)
+			{
+				std::uint64_t t = carry;
+				if (i < subtrahend.size())
+				{
+					t += static_cast<std::uint64_t>(subtrahend[i]) * factor;
+				}
+				const std::uint32_t low = static_cast<std::uint32_t>(t);
+				carry = t >> 32;
+				if (value[i] < low)
+				{
+					++carry;
+				}
+				value[i] -= low;
+			}
+			Trim(value);
+		}
+
+		// quotient = value / divisor, where the division is known to be exact.
+		void DivideExact(const Limbs& value, std::uint32_t divisor, Limbs& quotient)
+		{
+			quotient.resize(value.size());
+			std::uint64_t remainder = 0;
+			for (std::size_t i = value.size(); i-- > 0;)
+			{
+				const std::uint64_t t = (remainder << 32) | value[i];
+				quotient[i] = static_cast<std::uint32_t>(t / divisor);
+				remainder = t % divisor;
+			}
+			Trim(quotient);
+		}
+
+		// Splits a big integer into a double mantissa built from its top three limbs and a binary exponent.
+		std::pair<double, int> Split(const Limbs& value)
+		{
+			const std::size_t top = std::min<std::size_t>(value.size(), 3);
+			double mantissa = 0.0;
+			for (std::size_t i = 0; i < top; ++i)
+			{
+				mantissa = mantissa * 4294967296.0 + value[value.size() - 1 - i];
+			}
+			return { mantissa, static_cast<int>((value.size() - top) * 32) };
+		}
+
+		// numerator / denominator rounded to double, without overflowing on huge operands.
+		double Ratio(const Limbs& numerator, const Limbs& denominator)
+		{
+			if (numerator.empty())
+			{
+				return 0.0;
+			}
+			const auto [numeratorMantissa, numeratorExponent] = Split(numerator);
+			const auto [denominatorMantissa, denominatorExponent] = Split(denominator);
+			return std::ldexp(numeratorMantissa / denominatorMantissa, numeratorExponent - denominatorExponent);
+		}
+	}
+
+	Distribution Convolver::Add(const Distribution& lhs, const Distribution& rhs) const
+	{
+		if (lhs.IsEmpty() || rhs.IsEmpty())
+		{
+			return Distribution();
+		}
+
+		if (!lhs.IsDense() || !rhs.IsDense())
+		{
+			return AddMixed(lhs, rhs);
+		}
+
+		const auto& lhsProbabilities = lhs.GetProbabilities();
+		const auto& rhsProbabilities = rhs.GetProbabilities();
+		std::vector<double> result(lhsProbabilities.size() + rhsProbabilities.size() - 1, 0.0);
+		if (std::min(lhsProbabilities.size(), rhsProbabilities.size()) >= m_Settings.FftThreshold)
+		{
+			ConvolveFft(lhsProbabilities.data(), lhsProbabilities.size(), rhsProbabilities.data(), rhsProbabilities.size(), result.data());
+		}
+		else if (lhsProbabilities.size() <= rhsProbabilities.size())
+		{
+			// The kernels vectorize the inner loop, so the longer operand goes there.
+			ConvolutionKernels::ConvolveDirect(lhsProbabilities.data(), lhsProbabilities.size(), rhsProbabilities.data(), rhsProbabilities.size(), result.data());
+		}
+		else
+		{
+			ConvolutionKernels::ConvolveDirect(rhsProbabilities.data(), rhsProbabilities.size(), lhsProbabilities.data(), lhsProbabilities.size(), result.data());
+		}
+		return Distribution::FromDense(lhs.GetOffset() + rhs.GetOffset(), std::move(result));
+	}
+
+	Distribution Convolver::Subtract(const Distribution& lhs, const Distribution& rhs) const
+	{
+		return Add(lhs, rhs.Negated());
+	}
+
+	Distribution Convolver::Power(const Distribution& base, int exponent) const
+	{
+		if (exponent < 0)
+		{
+			throw std::invalid_argument("Convolution power must be non-negative.");
+		}
+
+		if (exponent == 0)
+		{
+			return Distribution{ {0, 1.0} };
+		}
+
+		// Exponentiation by squaring: walk the bits of the exponent below the highest one, squaring
+		// the accumulator and folding in one more copy of the base for each set bit.
+		int highestBit = 0;
+		while ((exponent >> highestBit) > 1)
+		{
+			++highestBit;
+		}
+
+		Distribution result = base;
+		for (int bit = highestBit - 1; bit >= 0; --bit)
+		{
+			result = Add(result, result);
+			if ((exponent >> bit) & 1)
+			{
+				result = Add(result, base);
+			}
+		}
+		return result;
+	}
+
+	Distribution Convolver::AddDice(const Distribution& lhs, int rolls, int sides) const
+	{
+		if (!PrefersSlidingWindow(lhs, rolls, sides))
+		{
+			return Add(lhs, UniformDiceSum(rolls, sides));
+		}
+
+		Distribution result = lhs;
+		for (int i = 0; i < rolls; ++i)
+		{
+			result = AddUniform(result, 1, sides);
+		}
+		return result;
+	}
+
+	Distribution Convolver::SubtractDice(const Distribution& lhs, int rolls, int sides) const
+	{
+		if (!PrefersSlidingWindow(lhs, rolls, sides))
+		{
+			return Subtract(lhs, UniformDiceSum(rolls, sides));
+		}
+
+		Distribution result = lhs;
+		for (int i = 0; i < rolls; ++i)
+		{
+			result = AddUniform(result, -sides, sides);
+		}
+		return result;
+	}
+
+	bool Convolver::PrefersSlidingWindow(const Distribution& lhs, int rolls, int sides) const
+	{
+		if (rolls <= 0 || sides <= 0 || lhs.IsEmpty() || !lhs.IsDense())
+		{
+			return false;
+		}
+
+		// Rough operation counts: every window step makes about three passes over a support that grows
+		// by S-1 per die, while the alternative is one convolution with the whole pool.
+		const double span = static_cast<double>(lhs.GetProbabilities().size());
+		const double poolSpan = static_cast<double>(rolls) * (sides - 1) + 1.0;
+		const double windowCost = 3.0 * rolls * (span + poolSpan / 2.0 + sides);
+
+		double convolutionCost = span * poolSpan;
+		if (std::min(span, poolSpan) >= static_cast<double>(m_Settings.FftThreshold))
+		{
+			const double n = span + poolSpan;
+			convolutionCost = 15.0 * n * std::log2(n);
+		}
+		return windowCost < convolutionCost;
+	}
+
+	Distribution Convolver::AddUniform(const Distribution& lhs, int lowestFace, int faces)
+	{
+		if (faces <= 0)
+		{
+			throw std::invalid_argument("Uniform distribution must have a positive number of faces.");
+		}
+
+		if (lhs.IsEmpty())
+		{
+			return Distribution();
+		}
+
+		if (!lhs.IsDense())
+		{
+			return AddMixed(lhs, Distribution::FromDense(lowestFace, std::vector<double>(static_cast<std::size_t>(faces), 1.0 / faces)));
+		}
+
+		const auto& probabilities = lhs.GetProbabilities();
+		std::vector<double> result(probabilities.size() + static_cast<std::size_t>(faces) - 1);
+		ConvolveUniform(probabilities.data(), probabilities.size(), static_cast<std::size_t>(faces), result.data());
+		return Distribution::FromDense(lhs.GetOffset() + lowestFace, std::move(result));
+	}
+
+	Distribution Convolver::UniformDiceSum(int rolls, int sides) const
+	{
+		if (rolls < 0 || sides <= 0)
+		{
+			throw std::invalid_argument("Dice pool must have non-negative rolls and positive sides.");
+		}
+
+		if (rolls == 0)
+		{
+			return Distribution{ {0, 1.0} };
+		}
+
+		// Estimated cost of the exact generator: half of the coefficients (the rest follow by symmetry),
+		// each touched a handful of times at the width of the final count, N * log2(S) bits.
+		const double coefficients = static_cast<double>(rolls) * (sides - 1) / 2.0 + 1.0;
+		const double limbs = static_cast<double>(rolls) * std::log2(static_cast<double>(sides)) / 32.0 + 1.0;
+		const double largestFactor = static_cast<double>(rolls) * (static_cast<double>(sides) + 1.0);
+		if (coefficients * limbs <= static_cast<double>(m_Settings.ExactDiceWorkLimit)
+			&& largestFactor <= static_cast<double>(std::numeric_limits<std::uint32_t>::max()))
+		{
+			return ExactUniformDiceSum(rolls, sides);
+		}
+
+		Distribution singleDie = Distribution::FromDense(1, std::vector<double>(static_cast<std::size_t>(sides), 1.0 / static_cast<double>(sides)));
+		return Power(singleDie, rolls);
+	}
+
+	Distribution Convolver::ExactUniformDiceSum(int rolls, int sides)
+	{
+		// The number of ways to roll a total of N + k is the coefficient c_k of Q(x) = (1 + x + ... + x^(S-1))^N.
+		// Differentiating Q(x) = ((1 - x^S) / (1 - x))^N gives the linear recurrence
+		//   k*c_k = (k-1+N)*c_(k-1) - (S(N+1)-k)*c_(k-S) + (N(S-1)-(k-S-1))*c_(k-S-1),
+		// whose right-hand side is always non-negative and exactly divisible by k. Only the last S+1
+		// coefficients are needed, so they live in a ring buffer and are converted to probabilities
+		// as soon as they are known.
+		const std::uint32_t n = static_cast<std::uint32_t>(rolls);
+		const std::uint32_t s = static_cast<std::uint32_t>(sides);
+		const std::size_t maxIndex = static_cast<std::size_t>(n) * (s - 1);
+		const std::size_t half = maxIndex / 2;
+
+		Limbs total{ 1 };
+		for (std::uint32_t i = 0; i < n; ++i)
+		{
+			Limbs next;
+			MultiplyAdd(next, total, s);
+			total = std::move(next);
+		}
+
+		std::vector<double> probabilities(maxIndex + 1, 0.0);
+		const std::size_t window = static_cast<std::size_t>(s) + 1;
+		std::vector<Limbs> recent(window);
+		recent[0] = Limbs{ 1 };
+		probabilities[0] = Ratio(recent[0], total);
+
+		Limbs accumulator;
+		for (std::size_t k = 1; k <= half; ++k)
+		{
+			accumulator.clear();
+			MultiplyAdd(accumulator, recent[(k - 1) % window], static_cast<std::uint32_t>(k - 1 + n));
+			if (k >= s + 1)
+			{
+				MultiplyAdd(accumulator, recent[(k - s - 1) % window], static_cast<std::uint32_t>(n * (s - 1) - (k - s - 1)));
+			}
+			if (k >= s)
+			{
+				MultiplySubtract(accumulator, recent[(k - s) % window], static_cast<std::uint32_t>(s * (n + 1) - k));
+			}
+			DivideExact(accumulator, static_cast<std::uint32_t>(k), recent[k % window]);
+			probabilities[k] = Ratio(recent[k % window], total);
+		}
+
+		for (std::size_t k = half + 1; k <= maxIndex; ++k)
+		{
+			probabilities[k] = probabilities[maxIndex - k];
+		}
+
+		return Distribution::FromDense(rolls, std::move(probabilities));
+	}
+
+	Distribution Convolver::AddMixed(const Distribution& lhs, const Distribution& rhs)
+	{
+		const auto [lhsMin, lhsMax] = lhs.GetMinMax();
+		const auto [rhsMin, rhsMax] = rhs.GetMinMax();
+		const std::size_t lhsCount = lhs.Size();
+		const std::size_t rhsCount = rhs.Size();
+		const int resultMin = lhsMin + rhsMin;
+		const std::size_t span = static_cast<std::size_t>(static_cast<long long>(lhsMax) + rhsMax - resultMin + 1);
+
+		// Scatter into a dense buffer when the result support is compact enough; FromDense will still
+		// pick the sparse representation if the result turns out to be mostly empty.
+		if (span <= std::max(Distribution::DenseMinimumSpan, lhsCount * rhsCount * Distribution::SparseFillRatio))
+		{
+			std::vector<double> result(span, 0.0);
+			for (const auto& [lhsValue, lhsProb] : lhs)
+			{
+				for (const auto& [rhsValue, rhsProb] : rhs)
+				{
+					result[static_cast<std::size_t>(lhsValue + rhsValue - resultMin)] += lhsProb * rhsProb;
+				}
+			}
+			return Distribution::FromDense(resultMin, std::move(result));
+		}
+
+		std::vector<std::pair<int, double>> outcomes;
+		outcomes.reserve(lhsCount * rhsCount);
+		for (const auto& [lhsValue, lhsProb] : lhs)
+		{
+			for (const auto& [rhsValue, rhsProb] : rhs)
+			{
+				outcomes.emplace_back(lhsValue + rhsValue, lhsProb * rhsProb);
+			}
+		}
+		return Distribution::FromOutcomes(outcomes);
+	}
+
+	void Convolver::ConvolveUniform(const double* values, std::size_t size, std::size_t faces, double* result)
+	{
+		// Van Herk / Gil-Werman window sums: the input (padded with faces-1 zeros on both sides) is cut
+		// into blocks of `faces` slots, and every window is the suffix sum of one block plus the prefix
+		// sum of the next. Unlike a running sum this never subtracts, so small tail probabilities keep
+		// their relative accuracy next to large ones.
+		const std::size_t resultSize = size + faces - 1;
+		const std::size_t paddedSize = (resultSize + faces - 1 + faces - 1) / faces * faces;
+		std::vector<double> padded(paddedSize, 0.0);
+		std::copy(values, values + size, padded.begin() + static_cast<std::ptrdiff_t>(faces - 1));
+
+		std::vector<double> prefix(paddedSize);
+		std::vector<double> suffix(paddedSize);
+		for (std::size_t block = 0; block < paddedSize; block += faces)
+		{
+			double sum = 0.0;
+			for (std::size_t i = block; i < block + faces; ++i)
+			{
+				sum += padded[i];
+				prefix[i] = sum;
+			}
+			sum = 0.0;
+			for (std::size_t i = block + faces; i-- > block;)
+			{
+				sum += padded[i];
+				suffix[i] = sum;
+			}
+		}
+
+		const double scale = 1.0 / static_cast<double>(faces);
+		for (std::size_t i = 0; i < resultSize; ++i)
+		{
+			const double window = i % faces == 0 ? suffix[i] : suffix[i] + prefix[i + faces - 1];
+			result[i] = window * scale;
+		}
+	}
+
+	void Convolver::ConvolveFft(const double* lhs, std::size_t lhsSize, const double* rhs, std::size_t rhsSize, double* result)
+	{
+		const std::size_t resultSize = lhsSize + rhsSize - 1;
+		std::size_t n = 1;
+		while (n < resultSize)
+		{
+			n <<= 1;
+		}
+
+		// Both real inputs are packed into one complex signal (lhs + i*rhs), so a single forward
+		// transform yields both spectra.
+		std::vector<Complex> packed(n);
+		for (std::size_t i = 0; i < lhsSize; ++i)
+		{
+			packed[i].real(lhs[i]);
+		}
+		for (std::size_t i = 0; i < rhsSize; ++i)
+		{
+			packed[i].imag(rhs[i]);
+		}
+		Fft(packed, false);
+
+		std::vector<Complex> product(n);
+		for (std::size_t k = 0; k < n; ++k)
+		{
+			const Complex z = packed[k];
+			const Complex zMirror = std::conj(packed[(n - k) & (n - 1)]);
+			const Complex lhsSpectrum = (z + zMirror) * 0.5;
+			const Complex rhsSpectrum = (z - zMirror) * Complex(0.0, -0.5);
+			product[k] = lhsSpectrum * rhsSpectrum;
+		}
+		Fft(product, true);
+
+		// The round-off of an FFT convolution is bounded by roughly eps * log2(n) * |lhs|_2 * |rhs|_2 in
+		// every slot, so slots that are not far above that bound carry few or no correct digits; the far
+		// tails of large pools are pure noise and may even be negative. Those slots are summed directly
+		// instead, which keeps the exact support and the relative accuracy of the tails.
+		const double trusted = TrustedFftMagnitude * std::numeric_limits<double>::epsilon() * std::log2(static_cast<double>(n))
+			* Norm2(lhs, lhsSize) * Norm2(rhs, rhsSize);
+		const NonZeroRun lhsRun = FindNonZeroRun(lhs, lhsSize);
+		const NonZeroRun rhsRun = FindNonZeroRun(rhs, rhsSize);
+		for (std::size_t i = 0; i < resultSize; ++i)
+		{
+			const double value = product[i].real();
+			result[i] = value > trusted ? value : SumSlot(lhs, lhsRun, rhs, rhsRun, i);
+		}
+	}
+}
@@ -0,0 +1,250 @@
+#include "DiceCalculator/Evaluation/DiceKernels.h"
+
+#include <algorithm>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define DICECALCULATOR_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define DICECALCULATOR_TARGET(features) __attribute__((target(features)))
+#else
+#define DICECALCULATOR_TARGET(features)
+#endif
+
+namespace DiceCalculator::Evaluation
+{
+	namespace
+	{
+		using State = DiceKernels::State;
+		constexpr std::size_t Lanes = DiceKernels::Lanes;
+
+		std::uint32_t RotateLeft(std::uint32_t value, int shift)
+		{
+			return (value << shift) | (value >> (32 - shift));
+		}
+
+		// One xoshiro128++ step of every lane.
+		void StepScalar(State& state, std::uint32_t* out)
+		{
+			auto& s = state.Words;
+			for (std::size_t lane = 0; lane < Lanes; ++lane)
+			{
+				out[lane] = RotateLeft(s[0][lane] + s[3][lane], 7) + s[0][lane];
+				const std::uint32_t t = s[1][lane] << 9;
+				s[2][lane] ^= s[0][lane];
+				s[3][lane] ^= s[1][lane];
+				s[1][lane] ^= s[2][lane];
+				s[0][lane] ^= s[3][lane];
+				s[2][lane] ^= t;
+				s[3][lane] = RotateLeft(s[3][lane], 11);
+			}
+		}
+
+		// One face in [1, sides] per lane. Lanes whose draw falls in the biased region are redrawn from a
+		// further step of all lanes, which is rare enough not to matter and keeps the kernels in lockstep.
+		void RollScalar(State& state, std::uint32_t sides, std::uint32_t threshold, std::uint32_t* faces)
+		{
+			std::uint32_t draws[Lanes];
+			StepScalar(state, draws);
+
+			bool rejected = false;
+			std::uint64_t products[Lanes];
+			for (std::size_t lane = 0; lane < Lanes; ++lane)
+			{
+				products[lane] = static_cast<std::uint64_t>(draws[lane]) * sides;
+				rejected |= static_cast<std::uint32_t>(products[lane]) < threshold;
+			}
+			while (rejected)
+			{
+				StepScalar(state, draws);
+				rejected = false;
+				for (std::size_t lane = 0; lane < Lanes; ++lane)
+				{
+					if (static_cast<std::uint32_t>(products[lane]) < threshold)
+					{
+						products[lane] = static_cast<std::uint64_t>(draws[lane]) * sides;
+						rejected |= static_cast<std::uint32_t>(products[lane]) < threshold;
+					}
+				}
+			}
+
+			for (std::size_t lane = 0; lane < Lanes; ++lane)
+			{
+				faces[lane] = static_cast<std::uint32_t>(products[lane] >> 32) + 1u;
+			}
+		}
+
+		void RollDiceScalar(State& state, int rolls, std::uint32_t sides, int* sums, int* firstFaces, std::size_t count)
+		{
+			const std::uint32_t threshold = (0u - sides) % sides;
+			std::uint32_t faces[Lanes];
+			for (std::size_t first = 0; first < count; first += Lanes)
+			{
+				const std::size_t width = std::min(Lanes, count - first);
+				std::uint32_t laneSums[Lanes] = {};
+				for (int die = 0; die < rolls; ++die)
+				{
+					RollScalar(state, sides, threshold, faces);
+					for (std::size_t lane = 0; lane < Lanes; ++lane)
+					{
+						laneSums[lane] += faces[lane];
+					}
+					if (die == 0 && firstFaces != nullptr)
+					{
+						std::copy(faces, faces + width, firstFaces + first);
+					}
+				}
+				std::copy(laneSums, laneSums + width, sums + first);
+			}
+		}
+
+#if defined(DICECALCULATOR_X86)
+		template<int Shift>
+		DICECALCULATOR_TARGET("avx2")
+		__m256i RotateLeftAvx2(__m256i value)
+		{
+			return _mm256_or_si256(_mm256_slli_epi32(value, Shift), _mm256_srli_epi32(value, 32 - Shift));
+		}
+
+		// Low and high 32 bits of the eight 32x32-bit products value * factor.
+		DICECALCULATOR_TARGET("avx2")
+		void MultiplyAvx2(__m256i value, __m256i factor, __m256i& low, __m256i& high)
+		{
+			const __m256i even = _mm256_mul_epu32(value, factor);
+			const __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(value, 32), factor);
+			low = _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA);
+			high = _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA);
+		}
+
+		// One xoshiro128++ step of every lane.
+		DICECALCULATOR_TARGET("avx2")
+		__m256i StepAvx2(__m256i& s0, __m256i& s1, __m256i& s2, __m256i& s3)
+		{
+			const __m256i result = _mm256_add_epi32(RotateLeftAvx2<7>(_mm256_add_epi32(s0, s3)), s0);
+			const __m256i t = _mm256_slli_epi32(s1, 9);
+			s2 = _mm256_xor_si256(s2, s0);
+			s3 = _mm256_xor_si256(s3, s1);
+			s1 = _mm256_xor_si256(s1, s2);
+			s0 = _mm256_xor_si256(s0, s3);
+			s2 = _mm256_xor_si256(s2, t);
+			s3 = RotateLeftAvx2<11>(s3);
+			return result;
+		}
+
+		DICECALCULATOR_TARGET("avx2")
+		void RollDiceAvx2(State& state, int rolls, std::uint32_t sides, int* sums, int* firstFaces, std::size_t count)
+		{
+			const std::uint32_t threshold = (0u - sides) % sides;
+			// AVX2 only compares signed integers, so both sides of `low < threshold` are biased by 2^31.
+			const __m256i signBit = _mm256_set1_epi32(static_cast<int>(0x80000000u));
+			const __m256i biasedThreshold = _mm256_xor_si256(_mm256_set1_epi32(static_cast<int>(threshold)), signBit);
+			const __m256i factor = _mm256_set1_epi32(static_cast<int>(sides));
+			const __m256i one = _mm256_set1_epi32(1);
+
+			__m256i s0 = _mm256_load_si256(reinterpret_cast<const __m256i*>(state.Words[0]));
+			__m256i s1 = _mm256_load_si256(reinterpret_cast<const __m256i*>(state.Words[1]));
+			__m256i s2 = _mm256_load_si256(reinterpret_cast<const __m256i*>(state.Words[2]));
+			__m256i s3 = _mm256_load_si256(reinterpret_cast<const __m256i*>(state.Words[3]));
+
+			alignas(32) std::int32_t buffer[Lanes];
+			for (std::size_t first = 0; first < count; first += Lanes)
+			{
+				const std::size_t width = std::min(Lanes, count - first);
+				__m256i laneSums = _mm256_setzero_si256();
+				for (int die = 0; die < rolls; ++die)
+				{
+					__m256i low;
+					__m256i high;
+					MultiplyAvx2(StepAvx2(s0, s1, s2, s3), factor, low, high);
+					__m256i rejected = _mm256_cmpgt_epi32(biasedThreshold, _mm256_xor_si256(low, signBit));
+					while (!_mm256_testz_si256(rejected, rejected))
+					{
+						__m256i retryLow;
+						__m256i retryHigh;
+						MultiplyAvx2(StepAvx2(s0, s1, s2, s3), factor, retryLow, retryHigh);
+						low = _mm256_blendv_epi8(low, retryLow, rejected);
+						high = _mm256_blendv_epi8(high, retryHigh, rejected);
+						rejected = _mm256_and_si256(rejected, _mm256_cmpgt_epi32(biasedThreshold, _mm256_xor_si256(low, signBit)));
+					}
+
+					const __m256i faces = _mm256_add_epi32(high, one);
+					laneSums = _mm256_add_epi32(laneSums, faces);
+					if (die == 0 && firstFaces != nullptr)
+					{
+						_mm256_store_si256(reinterpret_cast<__m256i*>(buffer), faces);
+						std::copy(buffer, buffer + width, firstFaces + first);
+					}
+				}
+
+				if (width == Lanes)
+				{
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(sums + first), laneSums);
+				}
+				else
+				{
+					_mm256_store_si256(reinterpret_cast<__m256i*>(buffer), laneSums);
+					std::copy(buffer, buffer + width, sums + first);
+				}
+			}
+
+			_mm256_store_si256(reinterpret_cast<__m256i*>(state.Words[0]), s0);
+			_mm256_store_si256(reinterpret_cast<__m256i*>(state.Words[1]), s1);
+			_mm256_store_si256(reinterpret_cast<__m256i*>(state.Words[2]), s2);
+			_mm256_store_si256(reinterpret_cast<__m256i*>(state.Words[3]), s3);
+		}
+#endif
+	}
+
+	bool DiceKernels::IsSupported(InstructionSet instructionSet)
+	{
+		switch (instructionSet)
+		{
+		case InstructionSet::Scalar:
+			return true;
+#if defined(DICECALCULATOR_X86)
+		case InstructionSet::Avx2:
+			return ConvolutionKernels::IsSupported(InstructionSet::Avx2);
+#endif
+		default:
+			return false;
+		}
+	}
+
+	DiceKernels::InstructionSet DiceKernels::GetBestSupported()
+	{
+		return IsSupported(InstructionSet::Avx2) ? InstructionSet::Avx2 : InstructionSet::Scalar;
+	}
+
+	std::string_view DiceKernels::GetName(InstructionSet instructionSet)
+	{
+		return ConvolutionKernels::GetName(instructionSet);
+	}
+
+	DiceKernels::RollKernel DiceKernels::GetRollKernel(InstructionSet instructionSet)
+	{
+		if (!IsSupported(instructionSet))
+		{
+			return nullptr;
+		}
+
+		switch (instructionSet)
+		{
+		case InstructionSet::Scalar:
+			return &RollDiceScalar;
+#if defined(DICECALCULATOR_X86)
+		case InstructionSet::Avx2:
+			return &RollDiceAvx2;
+#endif
+		default:
+			return nullptr;
+		}
+	}
+
+	void DiceKernels::RollDice(State& state, int rolls, std::uint32_t sides, int* sums, int* firstFaces, std::size_t count)
+	{
+		static const RollKernel kernel = GetRollKernel(GetBestSupported());
+		kernel(state, rolls, sides, sums, firstFaces, count);
+	}
+}
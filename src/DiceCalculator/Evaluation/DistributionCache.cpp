@@ -0,0 +1,98 @@
+#include "DiceCalculator/Evaluation/DistributionCache.h"
+
+#include <stdexcept>
+
+namespace DiceCalculator::Evaluation
+{
+	DistributionCache::DistributionCache(std::size_t capacity) : m_Capacity(capacity)
+	{
+		if (capacity == 0)
+		{
+			throw std::invalid_argument("Distribution cache capacity must be positive.");
+		}
+	}
+
+	std::shared_ptr<const Distribution> DistributionCache::Find(const Expressions::DiceAst& node)
+	{
+		std::lock_guard lock(m_Mutex);
+
+		auto entry = FindEntry(node);
+		if (entry == m_Entries.end())
+		{
+			++m_Statistics.Misses;
+			return nullptr;
+		}
+
+		++m_Statistics.Hits;
+		m_Entries.splice(m_Entries.begin(), m_Entries, entry);
+		return entry->Value;
+	}
+
+	void DistributionCache::Insert(const Expressions::DiceAst& node, Distribution distribution)
+	{
+		auto key = node.weak_from_this().lock();
+		if (!key)
+		{
+			return;
+		}
+		auto value = std::make_shared<const Distribution>(std::move(distribution));
+
+		std::lock_guard lock(m_Mutex);
+
+		// Another thread may have evaluated the same expression concurrently.
+		auto existing = FindEntry(node);
+		if (existing != m_Entries.end())
+		{
+			existing->Value = std::move(value);
+			m_Entries.splice(m_Entries.begin(), m_Entries, existing);
+			return;
+		}
+
+		if (m_Entries.size() >= m_Capacity)
+		{
+			auto victim = std::prev(m_Entries.end());
+			auto [first, last] = m_Index.equal_range(victim->Key->GetHash());
+			for (auto it = first; it != last; ++it)
+			{
+				if (it->second == victim)
+				{
+					m_Index.erase(it);
+					break;
+				}
+			}
+			m_Entries.pop_back();
+			++m_Statistics.Evictions;
+		}
+
+		m_Entries.push_front(Entry{ std::move(key), std::move(value) });
+		m_Index.emplace(node.GetHash(), m_Entries.begin());
+	}
+
+	void DistributionCache::Clear()
+	{
+		std::lock_guard lock(m_Mutex);
+		m_Entries.clear();
+		m_Index.clear();
+	}
+
+	DistributionCache::Statistics DistributionCache::GetStatistics() const
+	{
+		std::lock_guard lock(m_Mutex);
+		Statistics statistics = m_Statistics;
+		statistics.Size = m_Entries.size();
+		return statistics;
+	}
+
+	DistributionCache::EntryList::iterator DistributionCache::FindEntry(const Expressions::DiceAst& node)
+	{
+		auto [first, last] = m_Index.equal_range(node.GetHash());
+		for (auto it = first; it != last; ++it)
+		{
+			if (it->second->Key.get() == &node || it->second->Key->IsEqual(node))
+			{
+				return it->second;
+			}
+		}
+		return m_Entries.end();
+	}
+}
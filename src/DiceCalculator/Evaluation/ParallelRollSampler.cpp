@@ -0,0 +1,164 @@
+#include "DiceCalculator/Evaluation/ParallelRollSampler.h"
+#include "DiceCalculator/Evaluation/RollProgramCompiler.h"
+#include "DiceCalculator/Expressions/DiceAst.h"
+#include "DiceCalculator/Xoshiro128x8Random.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace DiceCalculator::Evaluation
+{
+	namespace
+	{
+		// Samples needed so that the DKW bound sqrt(ln(2 / alpha) / (2n)) drops to `distance`.
+		double KsSamplesNeeded(double distance, double confidence)
+		{
+			return std::log(2.0 / (1.0 - confidence)) / (2.0 * distance * distance);
+		}
+	}
+
+	double ParallelRollSampler::Estimate::GetStandardError(int value) const
+	{
+		if (Samples == 0)
+		{
+			return 0.0;
+		}
+		const double probability = Result[value];
+		return std::sqrt(probability * (1.0 - probability) / static_cast<double>(Samples));
+	}
+
+	void ParallelRollSampler::CountBlocks(const RollProgram& program, std::size_t firstBlock, std::size_t lastBlock, std::size_t samples, Distribution& counts) const
+	{
+		const std::size_t blocks = lastBlock - firstBlock;
+		const std::size_t threads = m_ThreadPool ? m_ThreadPool->GetThreadCount() : 1;
+		const std::size_t chunks = std::max<std::size_t>(1, std::min(blocks, threads * ChunksPerThread));
+
+		// Every chunk counts a contiguous range of blocks into its own histogram.
+		std::vector<Distribution> chunkCounts(chunks);
+		const auto countChunk = [&](std::size_t chunk)
+		{
+			RollProgram::Workspace workspace;
+			std::vector<int> results;
+			for (std::size_t block = firstBlock + blocks * chunk / chunks; block < firstBlock + blocks * (chunk + 1) / chunks; ++block)
+			{
+				results.resize(std::min(m_BatchSize, samples - block * m_BatchSize));
+				Xoshiro128x8Random random(m_Seed, block);
+				program.Run(random, results, workspace);
+				for (const int value : results)
+				{
+					chunkCounts[chunk].AddOutcome(value, 1.0);
+				}
+			}
+		};
+
+		if (m_ThreadPool)
+		{
+			m_ThreadPool->ForEach(chunks, countChunk);
+		}
+		else
+		{
+			for (std::size_t chunk = 0; chunk < chunks; ++chunk)
+			{
+				countChunk(chunk);
+			}
+		}
+
+		for (const auto& chunk : chunkCounts)
+		{
+			for (const auto& [value, count] : chunk)
+			{
+				counts.AddOutcome(value, count);
+			}
+		}
+	}
+
+	Distribution ParallelRollSampler::Sample(const Expressions::DiceAst& node, std::size_t samples) const
+	{
+		return Sample(RollProgramCompiler::Compile(node), samples);
+	}
+
+	Distribution ParallelRollSampler::Sample(const RollProgram& program, std::size_t samples) const
+	{
+		if (m_BatchSize == 0)
+		{
+			throw std::runtime_error("Batch size must be at least 1.");
+		}
+
+		Distribution result;
+		CountBlocks(program, 0, (samples + m_BatchSize - 1) / m_BatchSize, samples, result);
+		result.Normalize();
+		return result;
+	}
+
+	ParallelRollSampler::Estimate ParallelRollSampler::SampleAdaptive(const Expressions::DiceAst& node, const Precision& precision) const
+	{
+		return SampleAdaptive(RollProgramCompiler::Compile(node), precision);
+	}
+
+	ParallelRollSampler::Estimate ParallelRollSampler::SampleAdaptive(const RollProgram& program, const Precision& precision) const
+	{
+		if (m_BatchSize == 0)
+		{
+			throw std::runtime_error("Batch size must be at least 1.");
+		}
+		if (precision.Confidence <= 0.0 || precision.Confidence >= 1.0)
+		{
+			throw std::invalid_argument("Confidence must lie strictly between 0 and 1.");
+		}
+
+		const auto deadline = std::chrono::steady_clock::now() + precision.TimeBudget;
+		const std::size_t maxBlocks = std::max<std::size_t>(1, precision.MaxSamples / m_BatchSize);
+
+		Distribution counts;
+		Estimate estimate;
+		std::size_t blocks = 0;
+		// The first round covers MinSamples. Round sizes never depend on the pool, which only decides how
+		// the blocks of a round are split, so the stopping point is the same for every thread count.
+		std::size_t wantedBlocks = std::max<std::size_t>(1, (precision.MinSamples + m_BatchSize - 1) / m_BatchSize);
+		while (true)
+		{
+			const std::size_t nextBlocks = std::min(wantedBlocks, maxBlocks);
+			CountBlocks(program, blocks, nextBlocks, nextBlocks * m_BatchSize, counts);
+			blocks = nextBlocks;
+
+			estimate.Samples = blocks * m_BatchSize;
+			const double samples = static_cast<double>(estimate.Samples);
+
+			// p * (1 - p) of the worst outcome decides how many samples the standard error target needs.
+			double maxVariance = 0.0;
+			for (const auto& [value, count] : counts)
+			{
+				const double probability = count / samples;
+				maxVariance = std::max(maxVariance, probability * (1.0 - probability));
+			}
+			estimate.MaxStandardError = std::sqrt(maxVariance / samples);
+			estimate.KsDistance = std::sqrt(KsSamplesNeeded(1.0, precision.Confidence) / samples);
+
+			double samplesNeeded = 0.0;
+			if (precision.MaxStandardError > 0.0)
+			{
+				samplesNeeded = std::max(samplesNeeded, maxVariance / (precision.MaxStandardError * precision.MaxStandardError));
+			}
+			if (precision.MaxKsDistance > 0.0)
+			{
+				samplesNeeded = std::max(samplesNeeded, KsSamplesNeeded(precision.MaxKsDistance, precision.Confidence));
+			}
+
+			estimate.PrecisionMet = samples >= samplesNeeded;
+			if (estimate.PrecisionMet || blocks >= maxBlocks || std::chrono::steady_clock::now() >= deadline)
+			{
+				break;
+			}
+
+			// Aim straight for the estimated need, but at most double per round, since the variance
+			// estimate of the first rounds is still rough.
+			const double blocksNeeded = std::ceil(samplesNeeded / static_cast<double>(m_BatchSize));
+			wantedBlocks = blocksNeeded >= static_cast<double>(2 * blocks) ? 2 * blocks : std::max(blocks + 1, static_cast<std::size_t>(blocksNeeded));
+		}
+
+		counts.Normalize();
+		estimate.Result = std::move(counts);
+		return estimate;
+	}
+}
@@ -9,26 +9,36 @@ namespace DiceCalculator::Evaluation
 {
 	void RollAstVisitor::Visit(const Expressions::ConstantNode& node)
 	{
-		m_DiceRecords.clear();
+		m_DiceRecords.Records.clear();
+		m_DiceRecords.FirstD20 = 0;
 		m_Result = node.GetValue();
 	}
 
 	void RollAstVisitor::Visit(const Expressions::DiceNode& node)
 	{
-		m_DiceRecords.clear();
+		m_DiceRecords.Records.clear();
+		m_DiceRecords.FirstD20 = 0;
 		int total = 0;
 		for(int i = 0; i < node.GetRolls(); ++i)
 		{
 			int rolledValue = m_Random.NextInt(1, node.GetSides());
 			total += rolledValue;
-			m_DiceRecords.push_back({ node.GetSides(), rolledValue });
+			if (m_Tracking == Tracking::Records)
+			{
+				m_DiceRecords.Records.push_back({ node.GetSides(), rolledValue });
+			}
+			if (i == 0 && node.GetSides() == 20)
+			{
+				m_DiceRecords.FirstD20 = rolledValue;
+			}
 		}
 		m_Result = total;
 	}
 
 	void RollAstVisitor::Visit(const Expressions::OperatorNode& node)
 	{
-		m_DiceRecords.clear();
+		m_DiceRecords.Records.clear();
+		m_DiceRecords.FirstD20 = 0;
 		m_Result = node.GetOperator()->Evaluate(*this, node.GetOperands());
 	}
 }
\ No newline at end of file
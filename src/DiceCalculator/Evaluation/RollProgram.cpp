@@ -0,0 +1,173 @@
+#include "DiceCalculator/Evaluation/RollProgram.h"
+#include "DiceCalculator/Operators/AttackRoll.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace DiceCalculator::Evaluation
+{
+	namespace
+	{
+		bool IsRegisterOperation(RollProgram::OpCode code)
+		{
+			return code != RollProgram::OpCode::Constant && code != RollProgram::OpCode::Dice;
+		}
+
+		// Applies `operation` element-wise to two columns. `target` may alias either of them.
+		template<typename Operation>
+		void Combine(const int* left, const int* right, int* target, std::size_t count, Operation operation)
+		{
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				target[i] = operation(left[i], right[i]);
+			}
+		}
+
+		// d20 of a combined value: the first operand's, or the second's if the first rolled none.
+		void MergeD20(const int* left, const int* right, int* target, std::size_t count)
+		{
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				target[i] = left[i] != 0 ? left[i] : right[i];
+			}
+		}
+	}
+
+	RollProgram::RollProgram(std::vector<Instruction> instructions, std::uint32_t registerCount, std::uint32_t resultRegister) :
+		m_Instructions(std::move(instructions)), m_RegisterCount(registerCount), m_ResultRegister(resultRegister)
+	{
+		if (m_Instructions.empty() || resultRegister >= registerCount)
+		{
+			throw std::invalid_argument("RollProgram needs at least one instruction and a valid result register.");
+		}
+		for (const Instruction& instruction : m_Instructions)
+		{
+			const bool readsRegisters = IsRegisterOperation(instruction.Code);
+			if (instruction.Target >= registerCount || (readsRegisters && (static_cast<std::uint32_t>(instruction.Left) >= registerCount || static_cast<std::uint32_t>(instruction.Right) >= registerCount)))
+			{
+				throw std::invalid_argument("RollProgram instruction refers to a register out of range.");
+			}
+			m_TracksD20 |= instruction.Code == OpCode::AttackRoll;
+		}
+	}
+
+	void RollProgram::Run(IRandom& random, std::span<int> results, Workspace& workspace) const
+	{
+		if (m_Instructions.empty())
+		{
+			throw std::runtime_error("RollProgram is empty.");
+		}
+
+		const std::size_t count = results.size();
+		workspace.Values.resize(static_cast<std::size_t>(m_RegisterCount) * count);
+		workspace.D20Faces.resize(m_TracksD20 ? workspace.Values.size() : 0);
+
+		const auto column = [count](std::vector<int>& columns, std::uint32_t index)
+		{
+			return columns.data() + static_cast<std::size_t>(index) * count;
+		};
+
+		for (const Instruction& instruction : m_Instructions)
+		{
+			int* target = column(workspace.Values, instruction.Target);
+			int* targetD20 = m_TracksD20 ? column(workspace.D20Faces, instruction.Target) : nullptr;
+
+			if (instruction.Code == OpCode::Constant)
+			{
+				std::fill(target, target + count, instruction.Left);
+				if (targetD20 != nullptr)
+				{
+					std::fill(targetD20, targetD20 + count, 0);
+				}
+				continue;
+			}
+			if (instruction.Code == OpCode::Dice)
+			{
+				const bool rollsD20 = targetD20 != nullptr && instruction.Right == 20 && instruction.Left > 0;
+				random.SumDice(std::span<int>(target, count), rollsD20 ? std::span<int>(targetD20, count) : std::span<int>(), instruction.Left, instruction.Right);
+				if (targetD20 != nullptr && !rollsD20)
+				{
+					std::fill(targetD20, targetD20 + count, 0);
+				}
+				continue;
+			}
+
+			const int* left = column(workspace.Values, static_cast<std::uint32_t>(instruction.Left));
+			const int* right = column(workspace.Values, static_cast<std::uint32_t>(instruction.Right));
+			const int* leftD20 = m_TracksD20 ? column(workspace.D20Faces, static_cast<std::uint32_t>(instruction.Left)) : nullptr;
+			const int* rightD20 = m_TracksD20 ? column(workspace.D20Faces, static_cast<std::uint32_t>(instruction.Right)) : nullptr;
+
+			switch (instruction.Code)
+			{
+			case OpCode::Add:
+				Combine(left, right, target, count, [](int l, int r) { return l + r; });
+				break;
+			case OpCode::Subtract:
+				Combine(left, right, target, count, [](int l, int r) { return l - r; });
+				break;
+			case OpCode::LessThan:
+				Combine(left, right, target, count, [](int l, int r) { return l < r ? 1 : 0; });
+				break;
+			case OpCode::LessThanOrEqual:
+				Combine(left, right, target, count, [](int l, int r) { return l <= r ? 1 : 0; });
+				break;
+			case OpCode::Equal:
+				Combine(left, right, target, count, [](int l, int r) { return l == r ? 1 : 0; });
+				break;
+			case OpCode::NotEqual:
+				Combine(left, right, target, count, [](int l, int r) { return l != r ? 1 : 0; });
+				break;
+			case OpCode::GreaterThanOrEqual:
+				Combine(left, right, target, count, [](int l, int r) { return l >= r ? 1 : 0; });
+				break;
+			case OpCode::GreaterThan:
+				Combine(left, right, target, count, [](int l, int r) { return l > r ? 1 : 0; });
+				break;
+			case OpCode::Max:
+			case OpCode::Min:
+			{
+				const bool larger = instruction.Code == OpCode::Max;
+				for (std::size_t i = 0; i < count; ++i)
+				{
+					const bool takeRight = larger ? right[i] > left[i] : right[i] < left[i];
+					if (targetD20 != nullptr)
+					{
+						targetD20[i] = takeRight ? rightD20[i] : leftD20[i];
+					}
+					target[i] = takeRight ? right[i] : left[i];
+				}
+				// The d20 faces are already chosen along with the values.
+				continue;
+			}
+			case OpCode::AttackRoll:
+				for (std::size_t i = 0; i < count; ++i)
+				{
+					// A face of 0 means this sample rolled no d20 in the attack operand.
+					const int d20 = leftD20[i];
+					if (d20 >= Operators::AttackRoll::CriticalHitThreshold)
+					{
+						target[i] = 1;
+					}
+					else if (d20 != 0 && d20 <= Operators::AttackRoll::CriticalMissThreshold)
+					{
+						target[i] = 0;
+					}
+					else
+					{
+						target[i] = left[i] >= right[i] ? 1 : 0;
+					}
+				}
+				break;
+			default:
+				throw std::runtime_error("Unknown RollProgram instruction.");
+			}
+
+			if (targetD20 != nullptr)
+			{
+				MergeD20(leftD20, rightD20, targetD20, count);
+			}
+		}
+
+		const int* result = column(workspace.Values, m_ResultRegister);
+		std::copy(result, result + count, results.begin());
+	}
+}
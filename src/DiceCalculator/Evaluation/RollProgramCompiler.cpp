@@ -0,0 +1,64 @@
+#include "DiceCalculator/Evaluation/RollProgramCompiler.h"
+#include "DiceCalculator/Expressions/DiceNode.h"
+#include "DiceCalculator/Expressions/ConstantNode.h"
+#include "DiceCalculator/Expressions/OperatorNode.h"
+#include <algorithm>
+
+namespace DiceCalculator::Evaluation
+{
+	void RollProgramCompiler::Visit(const Expressions::ConstantNode& node)
+	{
+		m_Register = Emit(RollProgram::OpCode::Constant, node.GetValue(), 0);
+	}
+
+	void RollProgramCompiler::Visit(const Expressions::DiceNode& node)
+	{
+		m_Register = Emit(RollProgram::OpCode::Dice, node.GetRolls(), node.GetSides());
+	}
+
+	void RollProgramCompiler::Visit(const Expressions::OperatorNode& node)
+	{
+		m_Register = node.GetOperator()->Compile(*this, node.GetOperands());
+	}
+
+	std::uint32_t RollProgramCompiler::CompileOperand(const Expressions::DiceAst& operand)
+	{
+		operand.Accept(*this);
+		return m_Register;
+	}
+
+	std::uint32_t RollProgramCompiler::Emit(RollProgram::OpCode code, std::int32_t left, std::int32_t right)
+	{
+		if (code != RollProgram::OpCode::Constant && code != RollProgram::OpCode::Dice)
+		{
+			m_FreeRegisters.push_back(static_cast<std::uint32_t>(left));
+			m_FreeRegisters.push_back(static_cast<std::uint32_t>(right));
+		}
+
+		std::uint32_t target = m_RegisterCount;
+		if (m_FreeRegisters.empty())
+		{
+			++m_RegisterCount;
+		}
+		else
+		{
+			target = m_FreeRegisters.back();
+			m_FreeRegisters.pop_back();
+		}
+
+		m_Instructions.push_back({ code, target, left, right });
+		return target;
+	}
+
+	RollProgram RollProgramCompiler::GetProgram() const
+	{
+		return RollProgram(m_Instructions, m_RegisterCount, m_Register);
+	}
+
+	RollProgram RollProgramCompiler::Compile(const Expressions::DiceAst& node)
+	{
+		RollProgramCompiler compiler;
+		node.Accept(compiler);
+		return compiler.GetProgram();
+	}
+}
@@ -0,0 +1,133 @@
+#include "DiceCalculator/Expressions/AstFactory.h"
+
+#include <algorithm>
+
+namespace DiceCalculator::Expressions
+{
+	template<typename Node, typename Predicate>
+	std::shared_ptr<Node> AstFactory::FindLocked(std::size_t hash, Predicate matches)
+	{
+		auto [it, last] = m_Nodes.equal_range(hash);
+		while (it != last)
+		{
+			auto node = it->second.lock();
+			if (!node)
+			{
+				it = m_Nodes.erase(it);
+				continue;
+			}
+
+			if (auto typed = std::dynamic_pointer_cast<Node>(node); typed && matches(*typed))
+			{
+				return typed;
+			}
+			++it;
+		}
+		return nullptr;
+	}
+
+	void AstFactory::AddLocked(std::size_t hash, const std::shared_ptr<DiceAst>& node)
+	{
+		// Expired entries of other buckets are only seen by lookups that hash there, so sweep the
+		// whole table whenever it has doubled since the last sweep.
+		if (m_Nodes.size() >= m_SweepThreshold)
+		{
+			std::erase_if(m_Nodes, [](const auto& entry) { return entry.second.expired(); });
+			m_SweepThreshold = std::max<std::size_t>(1024, 2 * m_Nodes.size());
+		}
+		m_Nodes.emplace(hash, node);
+	}
+
+	std::shared_ptr<ConstantNode> AstFactory::MakeConstant(int value)
+	{
+		const std::size_t hash = ConstantNode::ComputeHash(value);
+		std::lock_guard lock(m_Mutex);
+
+		if (auto existing = FindLocked<ConstantNode>(hash, [&](const ConstantNode& node) { return node.GetValue() == value; }))
+		{
+			return existing;
+		}
+
+		auto node = std::make_shared<ConstantNode>(value);
+		AddLocked(hash, node);
+		return node;
+	}
+
+	std::shared_ptr<DiceNode> AstFactory::MakeDice(int rolls, int sides)
+	{
+		const std::size_t hash = DiceNode::ComputeHash(rolls, sides);
+		std::lock_guard lock(m_Mutex);
+
+		if (auto existing = FindLocked<DiceNode>(hash, [&](const DiceNode& node) { return node.GetRolls() == rolls && node.GetSides() == sides; }))
+		{
+			return existing;
+		}
+
+		auto node = std::make_shared<DiceNode>(rolls, sides);
+		AddLocked(hash, node);
+		return node;
+	}
+
+	std::shared_ptr<OperatorNode> AstFactory::MakeOperator(std::shared_ptr<DiceCalculator::Operators::DiceOperator> op, std::vector<std::shared_ptr<DiceAst>> operands)
+	{
+		for (auto& operand : operands)
+		{
+			operand = Intern(operand);
+		}
+
+		const std::size_t hash = OperatorNode::ComputeHash(op.get(), operands);
+		std::lock_guard lock(m_Mutex);
+
+		// Operands are interned, so comparing them by identity is a full structural comparison.
+		auto matches = [&](const OperatorNode& node)
+			{
+				return node.GetOperands() == operands && node.GetOperator()->IsEqual(*op);
+			};
+		if (auto existing = FindLocked<OperatorNode>(hash, matches))
+		{
+			return existing;
+		}
+
+		auto node = std::make_shared<OperatorNode>(std::move(op), std::move(operands));
+		AddLocked(hash, node);
+		return node;
+	}
+
+	std::shared_ptr<DiceAst> AstFactory::Intern(const std::shared_ptr<DiceAst>& ast)
+	{
+		if (!ast)
+		{
+			return ast;
+		}
+
+		{
+			// Fast path: the node itself came from this factory.
+			std::lock_guard lock(m_Mutex);
+			if (FindLocked<DiceAst>(ast->GetHash(), [&](const DiceAst& node) { return &node == ast.get(); }))
+			{
+				return ast;
+			}
+		}
+
+		if (auto constant = std::dynamic_pointer_cast<ConstantNode>(ast))
+		{
+			return MakeConstant(constant->GetValue());
+		}
+		if (auto dice = std::dynamic_pointer_cast<DiceNode>(ast))
+		{
+			return MakeDice(dice->GetRolls(), dice->GetSides());
+		}
+		if (auto operatorNode = std::dynamic_pointer_cast<OperatorNode>(ast))
+		{
+			return MakeOperator(operatorNode->GetOperator(), operatorNode->GetOperands());
+		}
+		return ast;
+	}
+
+	std::size_t AstFactory::GetNodeCount()
+	{
+		std::lock_guard lock(m_Mutex);
+		std::erase_if(m_Nodes, [](const auto& entry) { return entry.second.expired(); });
+		return m_Nodes.size();
+	}
+}
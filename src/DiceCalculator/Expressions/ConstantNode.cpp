@@ -2,9 +2,20 @@
 
 #include "DiceCalculator/Expressions/ConstantNode.h"
 #include "DiceCalculator/Evaluation/DiceAstVisitor.h"
+#include "DiceCalculator/Hashing.h"
+#include <functional>
 
 namespace DiceCalculator::Expressions
 {
+	ConstantNode::ConstantNode(int v) : m_Value(v), m_Hash(ComputeHash(v))
+	{
+	}
+
+	std::size_t ConstantNode::ComputeHash(int value)
+	{
+		return HashCombine(0x436f6e7374u, std::hash<int>{}(value));
+	}
+
     void ConstantNode::Accept(Evaluation::DiceAstVisitor& v) const { v.Visit(*this); }
 
 	int ConstantNode::GetValue() const { return m_Value; }
@@ -2,9 +2,20 @@
 
 #include "DiceCalculator/Expressions/DiceNode.h"
 #include "DiceCalculator/Evaluation/DiceAstVisitor.h"
+#include "DiceCalculator/Hashing.h"
+#include <functional>
 
 namespace DiceCalculator::Expressions
 {
+	DiceNode::DiceNode(int rolls, int sides) : m_Rolls(rolls), m_Sides(sides), m_Hash(ComputeHash(rolls, sides))
+	{
+	}
+
+	std::size_t DiceNode::ComputeHash(int rolls, int sides)
+	{
+		return HashCombine(HashCombine(0x44696365u, std::hash<int>{}(rolls)), std::hash<int>{}(sides));
+	}
+
 	void DiceNode::Accept(Evaluation::DiceAstVisitor& v) const { v.Visit(*this); }
 
 	bool DiceNode::IsEqual(const DiceAst& other) const
@@ -0,0 +1,126 @@
+#include "DiceCalculator/Expressions/FlatAst.h"
+#include "DiceCalculator/Expressions/AstFactory.h"
+
+#include <stdexcept>
+#include <unordered_map>
+
+namespace DiceCalculator::Expressions
+{
+	namespace
+	{
+		using DiceOperatorPtr = std::shared_ptr<DiceCalculator::Operators::DiceOperator>;
+
+		struct Builder
+		{
+			std::vector<FlatAst::Node>& Nodes;
+			std::vector<std::uint32_t>& Operands;
+			std::vector<DiceOperatorPtr>& Operators;
+			std::unordered_map<const DiceAst*, std::uint32_t> Indices;
+
+			std::uint32_t AddOperator(const DiceOperatorPtr& op)
+			{
+				for (std::size_t i = 0; i < Operators.size(); ++i)
+				{
+					if (Operators[i]->IsEqual(*op))
+					{
+						return static_cast<std::uint32_t>(i);
+					}
+				}
+				Operators.push_back(op);
+				return static_cast<std::uint32_t>(Operators.size() - 1);
+			}
+
+			// Appends `ast` after its operands and returns its index. Shared subtrees are appended once.
+			std::uint32_t Append(const DiceAst& ast)
+			{
+				if (auto it = Indices.find(&ast); it != Indices.end())
+				{
+					return it->second;
+				}
+
+				FlatAst::Node node{};
+				if (const auto* constant = dynamic_cast<const ConstantNode*>(&ast))
+				{
+					node.Kind = FlatAst::NodeKind::Constant;
+					node.Value = constant->GetValue();
+				}
+				else if (const auto* dice = dynamic_cast<const DiceNode*>(&ast))
+				{
+					node.Kind = FlatAst::NodeKind::Dice;
+					node.Value = dice->GetRolls();
+					node.Sides = dice->GetSides();
+				}
+				else if (const auto* operatorNode = dynamic_cast<const OperatorNode*>(&ast))
+				{
+					std::vector<std::uint32_t> operands;
+					operands.reserve(operatorNode->GetOperands().size());
+					for (const auto& operand : operatorNode->GetOperands())
+					{
+						if (!operand)
+						{
+							throw std::runtime_error("Operand is null in FlatAst.");
+						}
+						operands.push_back(Append(*operand));
+					}
+
+					node.Kind = FlatAst::NodeKind::Operator;
+					node.Operator = AddOperator(operatorNode->GetOperator());
+					node.FirstOperand = static_cast<std::uint32_t>(Operands.size());
+					node.OperandCount = static_cast<std::uint32_t>(operands.size());
+					Operands.insert(Operands.end(), operands.begin(), operands.end());
+				}
+				else
+				{
+					throw std::runtime_error("Unknown node type in FlatAst.");
+				}
+
+				const auto index = static_cast<std::uint32_t>(Nodes.size());
+				Nodes.push_back(node);
+				Indices.emplace(&ast, index);
+				return index;
+			}
+		};
+	}
+
+	FlatAst::FlatAst(const DiceAst& root)
+	{
+		Builder{ m_Nodes, m_Operands, m_Operators, {} }.Append(root);
+		m_Nodes.shrink_to_fit();
+		m_Operands.shrink_to_fit();
+	}
+
+	std::shared_ptr<DiceAst> FlatAst::ToAst(AstFactory& factory) const
+	{
+		if (m_Nodes.empty())
+		{
+			return nullptr;
+		}
+
+		std::vector<std::shared_ptr<DiceAst>> built;
+		built.reserve(m_Nodes.size());
+		for (const Node& node : m_Nodes)
+		{
+			switch (node.Kind)
+			{
+			case NodeKind::Constant:
+				built.push_back(factory.MakeConstant(node.Value));
+				break;
+			case NodeKind::Dice:
+				built.push_back(factory.MakeDice(node.Value, node.Sides));
+				break;
+			case NodeKind::Operator:
+			{
+				std::vector<std::shared_ptr<DiceAst>> operands;
+				operands.reserve(node.OperandCount);
+				for (const std::uint32_t operand : GetOperands(node))
+				{
+					operands.push_back(built[operand]);
+				}
+				built.push_back(factory.MakeOperator(m_Operators[node.Operator], std::move(operands)));
+				break;
+			}
+			}
+		}
+		return built.back();
+	}
+}
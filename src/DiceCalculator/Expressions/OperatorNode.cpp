@@ -2,11 +2,27 @@
 
 #include "DiceCalculator/Expressions/OperatorNode.h"
 #include "DiceCalculator/Evaluation/DiceAstVisitor.h"
+#include "DiceCalculator/Hashing.h"
 #include <typeindex>
 #include <stdexcept>
 
 namespace DiceCalculator::Expressions
 {
+    OperatorNode::OperatorNode(std::shared_ptr<DiceCalculator::Operators::DiceOperator> op, std::vector<std::shared_ptr<DiceAst>> ops)
+        : m_Operator(std::move(op)), m_Operands(std::move(ops)), m_Hash(ComputeHash(m_Operator.get(), m_Operands))
+    {
+    }
+
+    std::size_t OperatorNode::ComputeHash(const DiceCalculator::Operators::DiceOperator* op, const std::vector<std::shared_ptr<DiceAst>>& operands)
+    {
+        std::size_t hash = op ? op->GetHash() : 0;
+        for (const auto& operand : operands)
+        {
+            hash = HashCombine(hash, operand ? operand->GetHash() : 0);
+        }
+        return hash;
+    }
+
     void OperatorNode::Accept(Evaluation::DiceAstVisitor& v) const { v.Visit(*this); }
 
     const std::vector<std::shared_ptr<DiceAst>>& OperatorNode::GetOperands() const { return m_Operands; }
@@ -3,81 +3,66 @@
 
 namespace DiceCalculator::Operators
 {
-	bool Addition::Validate(std::vector<std::shared_ptr<DiceCalculator::Expressions::DiceAst>> operands) const
+	bool Addition::Validate(Operands operands) const
 	{
 		return true;
 	}
 
-	int Addition::Evaluate(DiceCalculator::Evaluation::RollAstVisitor& visitor, std::vector<std::shared_ptr<DiceCalculator::Expressions::DiceAst>> operands) const
+	int Addition::Evaluate(DiceCalculator::Evaluation::RollAstVisitor& visitor, Operands operands) const
 	{
 		int total = 0;
-		std::vector<DiceCalculator::Evaluation::RollAstVisitor::DiceRollRecord> totalRecords;
+		DiceCalculator::Evaluation::RollAstVisitor::RolledDice dice;
 		for (auto& op : operands)
 		{
 			op->Accept(visitor);
 			total += visitor.GetResult();
-			totalRecords.insert(totalRecords.end(), visitor.GetDiceRecords().begin(), visitor.GetDiceRecords().end());
+			visitor.AppendDice(dice);
 		}
-		visitor.SetDiceRecords(totalRecords);
+		visitor.SetDice(std::move(dice));
 		return total;
 	}
 
-	Distribution Addition::Evaluate(DiceCalculator::Evaluation::ConvolutionAstVisitor& visitor, std::vector<std::shared_ptr<DiceCalculator::Expressions::DiceAst>> operands) const
+	std::uint32_t Addition::Compile(DiceCalculator::Evaluation::RollProgramCompiler& compiler, Operands operands) const
 	{
-		Distribution totalDistribution = { {0, 1} };
-		for (auto& op : operands)
+		if (operands.empty())
 		{
-			op->Accept(visitor);
-			const Distribution& opDistribution = visitor.GetDistribution();
-			Distribution newTotalDistribution;
-			// Combine the current total distribution with the new operand distribution
-			for (const auto& [totalValue, totalProb] : totalDistribution)
-			{
-				for (const auto& [opValue, opProb] : opDistribution)
-				{
-					int newValue = totalValue + opValue;
-					double newProb = totalProb * opProb;
-					newTotalDistribution[newValue] += newProb;
-				}
-			}
-			totalDistribution = std::move(newTotalDistribution);
+			return compiler.Emit(Evaluation::RollProgram::OpCode::Constant, 0, 0);
 		}
-		return totalDistribution;
+
+		std::uint32_t total = compiler.CompileOperand(*operands[0]);
+		for (std::size_t i = 1; i < operands.size(); ++i)
+		{
+			const std::uint32_t operand = compiler.CompileOperand(*operands[i]);
+			total = compiler.Emit(Evaluation::RollProgram::OpCode::Add, static_cast<std::int32_t>(total), static_cast<std::int32_t>(operand));
+		}
+		return total;
 	}
 
-	std::vector<Combination> Addition::Evaluate(DiceCalculator::Evaluation::CombinationAstVisitor& visitor, std::vector<std::shared_ptr<DiceCalculator::Expressions::DiceAst>> operands) const
+	Distribution Addition::Evaluate(DiceCalculator::Evaluation::ConvolutionAstVisitor& visitor, Operands operands) const
 	{
-		// Start with a single empty combination
-		std::vector<Combination> total = { Combination{ 0, {} } };
+		return visitor.EvaluateSum(operands);
+	}
 
+	std::unique_ptr<DiceCalculator::Evaluation::CombinationStream> Addition::Evaluate(DiceCalculator::Evaluation::CombinationAstVisitor& visitor, Operands operands) const
+	{
+		std::vector<std::unique_ptr<Evaluation::CombinationStream>> parts;
+		parts.reserve(operands.size());
 		for (auto& op : operands)
 		{
 			op->Accept(visitor);
-			const auto& opCombinations = visitor.GetCombinations();
-
-			std::vector<Combination> newTotal;
-			newTotal.reserve(static_cast<size_t>(total.size()) * static_cast<size_t>(opCombinations.size()));
+			parts.push_back(visitor.TakeStream());
+		}
 
-			for (const auto& t : total)
+		// With no operands the product yields a single empty combination, the identity of addition.
+		return std::make_unique<Evaluation::ProductCombinationStream>(std::move(parts),
+			[](const std::vector<Combination>& current, Combination& out)
 			{
-				for (const auto& oc : opCombinations)
+				out.TotalValue = 0;
+				for (const auto& part : current)
 				{
-					Combination combined;
-					combined.TotalValue = t.TotalValue + oc.TotalValue;
-					combined.Rolls = t.Rolls;
-					combined.Rolls.insert(combined.Rolls.end(), oc.Rolls.begin(), oc.Rolls.end());
-					newTotal.push_back(std::move(combined));
-					if (newTotal.size() > Evaluation::CombinationAstVisitor::MaxCombinationsThreshold)
-					{
-						throw std::runtime_error("Combination evaluation exceeded maximum allowed combinations.");
-					}
+					out.TotalValue += part.TotalValue;
 				}
-			}
-
-			total = std::move(newTotal);
-		}
-
-		return total;
+			});
 	}
 
 	bool Addition::IsEqual(const DiceOperator& other) const
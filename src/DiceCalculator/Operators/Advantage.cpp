@@ -1,11 +1,12 @@
 #include "DiceCalculator/Operators/Advantage.h"
+#include "DiceCalculator/Hashing.h"
 #include "DiceCalculator/Expressions/ConstantNode.h"
 #include <stdexcept>
 #include <cmath>
 
 namespace DiceCalculator::Operators
 {
-	bool Advantage::Validate(std::vector<std::shared_ptr<DiceCalculator::Expressions::DiceAst>> operands) const
+	bool Advantage::Validate(Operands operands) const
 	{
 		if (operands.size() == 1)
 		{
@@ -20,7 +21,7 @@ namespace DiceCalculator::Operators
 		return false;
 	}
 
-	int Advantage::Evaluate(DiceCalculator::Evaluation::RollAstVisitor& visitor, std::vector<std::shared_ptr<DiceCalculator::Expressions::DiceAst>> operands) const
+	int Advantage::Evaluate(DiceCalculator::Evaluation::RollAstVisitor& visitor, Operands operands) const
 	{
 		if (operands.size() > 2)
 		{
@@ -28,49 +29,53 @@ namespace DiceCalculator::Operators
 		}
 
 		int rerolls = GetRerolls(operands);
-		
-		std::vector<int> rolledValues;
-		std::vector<std::vector<Evaluation::RollAstVisitor::DiceRollRecord>> rollRecords;
+		if (rerolls < 1)
+		{
+			throw std::runtime_error("Advantage operator performed no rolls.");
+		}
 
+		// Only the best attempt so far is kept. The visitor clears its records on every visit, so the
+		// dice of a losing attempt are simply overwritten, and nothing is allocated when only totals
+		// are tracked. Ties keep the earlier attempt.
+		int bestValue = 0;
+		Evaluation::RollAstVisitor::RolledDice bestDice;
 		for (int i = 0; i < rerolls; ++i)
 		{
 			operands[0]->Accept(visitor);
-			int result = visitor.GetResult();
-			auto records = visitor.GetDiceRecords();
-			rolledValues.push_back( result );
-			rollRecords.push_back(records);
+			const int result = visitor.GetResult();
+			const bool better = m_Mode == Mode::Advantage ? result > bestValue : result < bestValue;
+			if (i == 0 || better)
+			{
+				bestValue = result;
+				bestDice = visitor.TakeDice();
+			}
 		}
 
-		if (rolledValues.empty())
+		visitor.SetDice(std::move(bestDice));
+		return bestValue;
+	}
+
+	std::uint32_t Advantage::Compile(DiceCalculator::Evaluation::RollProgramCompiler& compiler, Operands operands) const
+	{
+		if (operands.size() > 2)
 		{
-			throw std::runtime_error("Advantage operator performed no rolls.");
+			throw std::runtime_error("Too many arguments for Advantage()");
 		}
 
-		// Find index of max (advantage) or min (disadvantage)
-		std::size_t bestIndex = 0;
-		for (std::size_t i = 1; i < rolledValues.size(); ++i)
+		int rerolls = GetRerolls(operands);
+
+		// Every attempt is compiled separately so that each one rolls its own dice.
+		const auto code = m_Mode == Mode::Advantage ? Evaluation::RollProgram::OpCode::Max : Evaluation::RollProgram::OpCode::Min;
+		std::uint32_t best = compiler.CompileOperand(*operands[0]);
+		for (int attempt = 1; attempt < rerolls; ++attempt)
 		{
-			if (m_Mode == Mode::Advantage)
-			{
-				if (rolledValues[i] > rolledValues[bestIndex])
-				{
-					bestIndex = i;
-				}
-			}
-			else
-			{
-				if (rolledValues[i] < rolledValues[bestIndex])
-				{
-					bestIndex = i;
-				}
-			}
+			const std::uint32_t result = compiler.CompileOperand(*operands[0]);
+			best = compiler.Emit(code, static_cast<std::int32_t>(best), static_cast<std::int32_t>(result));
 		}
-
-		visitor.SetDiceRecords(rollRecords[bestIndex]);
-		return rolledValues[bestIndex];
+		return best;
 	}
 
-	Distribution Advantage::Evaluate(DiceCalculator::Evaluation::ConvolutionAstVisitor& visitor, std::vector<std::shared_ptr<DiceCalculator::Expressions::DiceAst>> operands) const
+	Distribution Advantage::Evaluate(DiceCalculator::Evaluation::ConvolutionAstVisitor& visitor, Operands operands) const
 	{
 		if (operands.size() > 2)
 		{
@@ -83,7 +88,7 @@ namespace DiceCalculator::Operators
 		operands[0]->Accept(visitor);
 		const Distribution& d = visitor.GetDistribution();
 
-		if (d.Size() == 0)
+		if (d.IsEmpty())
 		{
 			return Distribution();
 		}
@@ -98,10 +103,8 @@ namespace DiceCalculator::Operators
 		if (m_Mode == Mode::Advantage)
 		{
 			double cumulative = 0.0;
-			for (auto const& p : d.GetData())
+			for (const auto& [k, pk] : d)
 			{
-				int k = p.first;
-				double pk = p.second;
 				double Fk = cumulative + pk;
 				double Fprev = cumulative;
 				double prob = std::pow(Fk, n) - std::pow(Fprev, n);
@@ -112,11 +115,9 @@ namespace DiceCalculator::Operators
 		else
 		{
 			double suffix = 0.0;
-			auto const& data = d.GetData();
-			for (auto it = data.rbegin(); it != data.rend(); ++it)
+			for (auto it = d.rbegin(); it != d.rend(); ++it)
 			{
-				int k = it->first;
-				double pk = it->second;
+				const auto [k, pk] = *it;
 				double Sk = suffix + pk;        // P(X >= k)
 				double Snext = suffix;         // P(X >= k+1)
 				double prob = std::pow(Sk, n) - std::pow(Snext, n);
@@ -128,7 +129,7 @@ namespace DiceCalculator::Operators
 		return result;
 	}
 
-	std::vector<Combination> Advantage::Evaluate(DiceCalculator::Evaluation::CombinationAstVisitor& visitor, std::vector<std::shared_ptr<DiceCalculator::Expressions::DiceAst>> operands) const
+	std::unique_ptr<DiceCalculator::Evaluation::CombinationStream> Advantage::Evaluate(DiceCalculator::Evaluation::CombinationAstVisitor& visitor, Operands operands) const
 	{
 		if (operands.size() > 2)
 		{
@@ -137,84 +138,54 @@ namespace DiceCalculator::Operators
 
 		int rerolls = GetRerolls(operands);
 
-		// Get all combinations for a single roll of the operand.
-		operands[0]->Accept(visitor);
-		const auto& baseCombos = visitor.GetCombinations();
-		if (baseCombos.empty())
-		{
-			return {};
-		}
-
 		const int n = std::max(1, rerolls);
 		if (n == 1)
 		{
 			// Only one roll, just pass-through.
-			return baseCombos;
+			operands[0]->Accept(visitor);
+			return visitor.TakeStream();
 		}
 
-		// Build cartesian products of 'n' independent rolls of the same operand.
-		// For each product, select the best attempt according to mode and record ONLY that attempt's rolls.
-		std::vector<Combination> result;
-		// total count = baseCombos.size() ^ n
-		// We iterate using an index vector like mixed-radix odometer.
-		const size_t m = baseCombos.size();
-		std::vector<size_t> indices(static_cast<size_t>(n), 0);
-
-		// Helper to push current product's selected attempt
-		auto emitCurrent = [&]()
-		{
-			// Find best attempt index among current indices
-			size_t bestIdxInProduct = 0;
-			for (size_t i = 1; i < indices.size(); ++i)
-			{
-				const auto& cur = baseCombos[indices[i]].TotalValue;
-				const auto& best = baseCombos[indices[bestIdxInProduct]].TotalValue;
-				if (m_Mode == Mode::Advantage)
-				{
-					if (cur > best) bestIdxInProduct = i;
-				}
-				else
-				{
-					if (cur < best) bestIdxInProduct = i;
-				}
-			}
-
-			const auto& chosen = baseCombos[indices[bestIdxInProduct]];
-			Combination out;
-			out.TotalValue = chosen.TotalValue;
-			out.Rolls = chosen.Rolls; // ONLY record the chosen attempt's rolls
-			result.push_back(std::move(out));
-			if (result.size() > Evaluation::CombinationAstVisitor::MaxCombinationsThreshold)
-			{
-				throw std::runtime_error("Combination evaluation exceeded maximum allowed combinations.");
-			}
-		};
-
-		// Odometer iteration over m^n combinations
-		bool done = false;
-		while (!done)
+		// Stream the cartesian product of 'n' independent rolls of the same operand. The first attempt
+		// changes fastest, so attempt i is the part at n - 1 - i.
+		std::vector<std::unique_ptr<Evaluation::CombinationStream>> parts;
+		parts.reserve(static_cast<size_t>(n));
+		for (int i = 0; i < n; ++i)
 		{
-			emitCurrent();
+			operands[0]->Accept(visitor);
+			parts.push_back(visitor.TakeStream());
+		}
 
-			// increment indices
-			for (size_t pos = 0; pos < indices.size(); ++pos)
+		// For each product, select the best attempt according to mode and record ONLY that attempt's rolls.
+		return std::make_unique<Evaluation::ProductCombinationStream>(std::move(parts),
+			[mode = m_Mode](const std::vector<Combination>& current, Combination& out)
 			{
-				if (++indices[pos] < m)
-				{
-					break; // carry resolved
-				}
-				indices[pos] = 0; // reset and carry to next
-				if (pos + 1 == indices.size())
+				const size_t attempts = current.size();
+				auto attempt = [&](size_t i) -> const Combination& { return current[attempts - 1 - i]; };
+
+				// Find best attempt index among current attempts
+				size_t bestIdxInProduct = 0;
+				for (size_t i = 1; i < attempts; ++i)
 				{
-					done = true;
+					const auto& cur = attempt(i).TotalValue;
+					const auto& best = attempt(bestIdxInProduct).TotalValue;
+					if (mode == Mode::Advantage)
+					{
+						if (cur > best) bestIdxInProduct = i;
+					}
+					else
+					{
+						if (cur < best) bestIdxInProduct = i;
+					}
 				}
-			}
-		}
 
-		return result;
+				const auto& chosen = attempt(bestIdxInProduct);
+				out.TotalValue = chosen.TotalValue;
+				out.Rolls = chosen.Rolls; // ONLY record the chosen attempt's rolls
+			}, Evaluation::ProductCombinationStream::Rolls::FromCombiner);
 	}
 
-	int Advantage::GetRerolls(std::vector<std::shared_ptr<DiceCalculator::Expressions::DiceAst>> operands) const
+	int Advantage::GetRerolls(Operands operands) const
 	{
 		int rerolls = 2; // default
 		if (operands.size() == 2)
@@ -243,6 +214,11 @@ namespace DiceCalculator::Operators
 		return false;
 	}
 
+	std::size_t Advantage::GetHash() const
+	{
+		return HashCombine(DiceOperator::GetHash(), static_cast<std::size_t>(m_Mode));
+	}
+
 	std::vector<RegistryEntry> Advantage::Register()
 	{
 		return {
@@ -7,7 +7,7 @@
 
 namespace DiceCalculator::Operators
 {
-	bool AttackRoll::Validate(std::vector<std::shared_ptr<DiceCalculator::Expressions::DiceAst>> operands) const
+	bool AttackRoll::Validate(Operands operands) const
 	{
 		if (operands.size() != 2)
 		{
@@ -24,7 +24,7 @@ namespace DiceCalculator::Operators
 		return false;
 	}
 
-	int AttackRoll::Evaluate(DiceCalculator::Evaluation::RollAstVisitor& visitor, std::vector<std::shared_ptr<DiceCalculator::Expressions::DiceAst>> operands) const
+	int AttackRoll::Evaluate(DiceCalculator::Evaluation::RollAstVisitor& visitor, Operands operands) const
 	{
 		if (!Validate(operands))
 		{
@@ -33,34 +33,37 @@ namespace DiceCalculator::Operators
 
 		operands[0]->Accept(visitor);
 		int result1 = visitor.GetResult();
-		auto records1 = visitor.GetDiceRecords();
+		auto dice = visitor.TakeDice();
+		// The crit check only looks at the attack's d20, which is tracked even without dice records.
+		const int d20 = dice.FirstD20;
 		operands[1]->Accept(visitor);
 		int result2 = visitor.GetResult();
-		auto records2 = visitor.GetDiceRecords();
+		visitor.AppendDice(dice);
+		visitor.SetDice(std::move(dice));
 
-		auto recordsTotal = records1;
-		recordsTotal.insert(recordsTotal.end(), records2.begin(), records2.end());
-		visitor.SetDiceRecords(recordsTotal);
+		if (d20 >= CriticalHitThreshold)
+		{
+			return 1; // Critical hit
+		}
 
-		for (const auto& record : records1)
+		if (d20 != 0 && d20 <= CriticalMissThreshold)
 		{
-			if (record.Sides != 20)
-			{
-				continue;				
-			}
+			return 0; // Critical miss
+		}
 
-			if (record.RolledValue >= CriticalHitThreshold)
-			{
-				return 1; // Critical hit
-			}
+		return result1 >= result2 ? 1 : 0;
+	}
 
-			if (record.RolledValue <= CriticalMissThreshold)
-			{
-				return 0; // Critical miss
-			}
+	std::uint32_t AttackRoll::Compile(DiceCalculator::Evaluation::RollProgramCompiler& compiler, Operands operands) const
+	{
+		if (!Validate(operands))
+		{
+			throw std::runtime_error("AttackRoll operands are invalid.");
 		}
 
-		return result1 >= result2 ? 1 : 0;
+		const std::uint32_t attack = compiler.CompileOperand(*operands[0]);
+		const std::uint32_t target = compiler.CompileOperand(*operands[1]);
+		return compiler.Emit(Evaluation::RollProgram::OpCode::AttackRoll, static_cast<std::int32_t>(attack), static_cast<std::int32_t>(target));
 	}
 
 	bool AttackRoll::ValidateAttackRollOperand(const std::shared_ptr<DiceCalculator::Expressions::DiceAst>& operand, bool& hasD20) const
@@ -83,7 +86,7 @@ namespace DiceCalculator::Operators
 		}
 	}
 
-	Distribution AttackRoll::Evaluate(DiceCalculator::Evaluation::ConvolutionAstVisitor& visitor, std::vector<std::shared_ptr<DiceCalculator::Expressions::DiceAst>> operands) const
+	Distribution AttackRoll::Evaluate(DiceCalculator::Evaluation::ConvolutionAstVisitor& visitor, Operands operands) const
 	{
 		if (!Validate(operands))
 		{
@@ -94,56 +97,35 @@ namespace DiceCalculator::Operators
 	}
 
 
-	std::vector<Combination> AttackRoll::Evaluate(DiceCalculator::Evaluation::CombinationAstVisitor& visitor, std::vector<std::shared_ptr<DiceCalculator::Expressions::DiceAst>> operands) const
+	std::unique_ptr<DiceCalculator::Evaluation::CombinationStream> AttackRoll::Evaluate(DiceCalculator::Evaluation::CombinationAstVisitor& visitor, Operands operands) const
 	{
 		if (!Validate(operands))
 		{
 			throw std::runtime_error("AttackRoll operands are invalid.");
 		}
 
-		// Evaluate combinations for both operands
+		// Stream combinations of both operands
+		std::vector<std::unique_ptr<Evaluation::CombinationStream>> parts;
 		operands[0]->Accept(visitor);
-		auto leftCombinations = visitor.GetCombinations();
-
+		parts.push_back(visitor.TakeStream());
 		operands[1]->Accept(visitor);
-		auto rightCombinations = visitor.GetCombinations();
+		parts.push_back(visitor.TakeStream());
 
-		if (leftCombinations.empty() || rightCombinations.empty())
-		{
-			return {};
-		}
-
-		std::vector<Combination> result;
-		size_t resultSizeEstimate = static_cast<size_t>(leftCombinations.size()) * static_cast<size_t>(rightCombinations.size());
-		if (resultSizeEstimate > Evaluation::CombinationAstVisitor::MaxCombinationsThreshold)
-		{
-			throw std::runtime_error("Combination evaluation exceeded maximum allowed combinations.");
-		}
-		result.reserve(resultSizeEstimate);
-		
-
-		for (const auto& lc : leftCombinations)
-		{
-			// Find the single d20 roll in the left operand's rolls
-			int d20Value = 0;
-			bool foundD20 = false;
-			for (const auto& r : lc.Rolls)
+		return std::make_unique<Evaluation::ProductCombinationStream>(std::move(parts),
+			[](const std::vector<Combination>& current, Combination& out)
 			{
-				if (r.Sides == 20)
+				const Combination& lc = current[0];
+				const Combination& rc = current[1];
+
+				// Find the single d20 roll in the left operand's rolls; exactly one is guaranteed by Validate.
+				const std::size_t d20Position = lc.Rolls.FindSides(20);
+				if (d20Position == lc.Rolls.size())
 				{
-					d20Value = r.Value;
-					foundD20 = true;
-					break; // exactly one is guaranteed by Validate
+					// Should not happen due to Validate, but guard anyway
+					throw std::runtime_error("AttackRoll left operand does not contain a d20 roll.");
 				}
-			}
-			if (!foundD20)
-			{
-				// Should not happen due to Validate, but guard anyway
-				throw std::runtime_error("AttackRoll left operand does not contain a d20 roll.");
-			}
+				const int d20Value = lc.Rolls[d20Position].Value;
 
-			for (const auto& rc : rightCombinations)
-			{
 				int outcome = 0;
 
 				// Critical miss/hit override normal comparison
@@ -160,16 +142,8 @@ namespace DiceCalculator::Operators
 					outcome = (lc.TotalValue >= rc.TotalValue) ? 1 : 0;
 				}
 
-				Combination combined;
-				combined.TotalValue = outcome;
-				combined.Rolls = lc.Rolls;
-				combined.Rolls.insert(combined.Rolls.end(), rc.Rolls.begin(), rc.Rolls.end());
-
-				result.push_back(std::move(combined));
-			}
-		}
-
-		return result;
+				out.TotalValue = outcome;
+			});
 	}
 
 	bool AttackRoll::IsEqual(const DiceOperator& other) const
@@ -1,14 +1,15 @@
 #include "DiceCalculator/Operators/Comparison.h"
+#include "DiceCalculator/Hashing.h"
 #include <stdexcept>
 
 namespace DiceCalculator::Operators
 {
-	bool Comparison::Validate(std::vector<std::shared_ptr<DiceCalculator::Expressions::DiceAst>> operands) const
+	bool Comparison::Validate(Operands operands) const
 	{
 		return operands.size() == 2;
 	}
 
-	int Comparison::Evaluate(DiceCalculator::Evaluation::RollAstVisitor& visitor, std::vector<std::shared_ptr<DiceCalculator::Expressions::DiceAst>> operands) const
+	int Comparison::Evaluate(DiceCalculator::Evaluation::RollAstVisitor& visitor, Operands operands) const
 	{
 		if (!Validate(operands))
 		{
@@ -17,14 +18,11 @@ namespace DiceCalculator::Operators
 
 		operands[0]->Accept(visitor);
 		int result1 = visitor.GetResult();
-		auto records1 = visitor.GetDiceRecords();
+		auto dice = visitor.TakeDice();
 		operands[1]->Accept(visitor);
 		int result2 = visitor.GetResult();
-		auto records2 = visitor.GetDiceRecords();
-
-		auto recordsTotal = records1;
-		recordsTotal.insert(recordsTotal.end(), records2.begin(), records2.end());
-		visitor.SetDiceRecords(recordsTotal);
+		visitor.AppendDice(dice);
+		visitor.SetDice(std::move(dice));
 
 		switch (m_Mode)
 		{
@@ -46,35 +44,71 @@ namespace DiceCalculator::Operators
 		
 	}
 
+	std::uint32_t Comparison::Compile(DiceCalculator::Evaluation::RollProgramCompiler& compiler, Operands operands) const
+	{
+		if (!Validate(operands))
+		{
+			throw std::runtime_error("Comparison operator requires exactly one operand.");
+		}
+
+		Evaluation::RollProgram::OpCode code;
+		switch (m_Mode)
+		{
+			case Mode::LessThan:
+				code = Evaluation::RollProgram::OpCode::LessThan;
+				break;
+			case Mode::LessThanOrEqual:
+				code = Evaluation::RollProgram::OpCode::LessThanOrEqual;
+				break;
+			case Mode::Equal:
+				code = Evaluation::RollProgram::OpCode::Equal;
+				break;
+			case Mode::NotEqual:
+				code = Evaluation::RollProgram::OpCode::NotEqual;
+				break;
+			case Mode::GreaterThanOrEqual:
+				code = Evaluation::RollProgram::OpCode::GreaterThanOrEqual;
+				break;
+			case Mode::GreaterThan:
+				code = Evaluation::RollProgram::OpCode::GreaterThan;
+				break;
+			default:
+				throw std::runtime_error("Invalid comparison mode.");
+		}
+
+		const std::uint32_t lhs = compiler.CompileOperand(*operands[0]);
+		const std::uint32_t rhs = compiler.CompileOperand(*operands[1]);
+		return compiler.Emit(code, static_cast<std::int32_t>(lhs), static_cast<std::int32_t>(rhs));
+	}
+
 
-	Distribution Comparison::Evaluate(DiceCalculator::Evaluation::ConvolutionAstVisitor& visitor, std::vector<std::shared_ptr<DiceCalculator::Expressions::DiceAst>> operands) const
+	Distribution Comparison::Evaluate(DiceCalculator::Evaluation::ConvolutionAstVisitor& visitor, Operands operands) const
 	{
 		if (!Validate(operands))
 		{
 			throw std::runtime_error("Comparison operands are invalid.");
 		}
 
-		operands[0]->Accept(visitor);
-		Distribution d1 = visitor.GetDistribution();
+		auto distributions = visitor.EvaluateOperands(operands);
+		const Distribution& d1 = distributions[0];
 
-		if (d1.Size() == 0)
+		if (d1.IsEmpty())
 		{
 			throw std::runtime_error("First operand has an empty distribution.");
 		}
 
-		operands[1]->Accept(visitor);
-		Distribution d2 = visitor.GetDistribution();
+		const Distribution& d2 = distributions[1];
 
-		if (d2.Size() == 0)
+		if (d2.IsEmpty())
 		{
 			throw std::runtime_error("First operand has an empty distribution.");
 		}
 
 		Distribution result;
 
-		for (const auto& [value1, prob1] : d1.GetData())
+		for (const auto& [value1, prob1] : d1)
 		{
-			for (const auto& [value2, prob2] : d2.GetData())
+			for (const auto& [value2, prob2] : d2)
 			{
 				bool comparisonResult = false;
 				switch (m_Mode)
@@ -110,73 +144,52 @@ namespace DiceCalculator::Operators
 	}
 
 
-	std::vector<Combination> Comparison::Evaluate(DiceCalculator::Evaluation::CombinationAstVisitor& visitor, std::vector<std::shared_ptr<DiceCalculator::Expressions::DiceAst>> operands) const
+	std::unique_ptr<DiceCalculator::Evaluation::CombinationStream> Comparison::Evaluate(DiceCalculator::Evaluation::CombinationAstVisitor& visitor, Operands operands) const
 	{
 		if (!Validate(operands))
 		{
 			throw std::runtime_error("Comparison operands are invalid.");
 		}
 
-		// Evaluate combinations for both operands
+		// Stream combinations of both operands; if either side has none, so does the product
+		std::vector<std::unique_ptr<Evaluation::CombinationStream>> parts;
 		operands[0]->Accept(visitor);
-		auto leftCombinations = visitor.GetCombinations();
-
+		parts.push_back(visitor.TakeStream());
 		operands[1]->Accept(visitor);
-		auto rightCombinations = visitor.GetCombinations();
-
-		if (leftCombinations.empty() || rightCombinations.empty())
-		{
-			// If any side has no combinations, result is empty set
-			return {};
-		}
-
-		std::vector<Combination> result;
-		size_t resultSizeEstimate = static_cast<size_t>(leftCombinations.size()) * static_cast<size_t>(rightCombinations.size());
-		if (resultSizeEstimate > Evaluation::CombinationAstVisitor::MaxCombinationsThreshold)
-		{
-			throw std::runtime_error("Combination evaluation exceeded maximum allowed combinations.");
-		}
-		result.reserve(resultSizeEstimate);
+		parts.push_back(visitor.TakeStream());
 
-		for (const auto& lc : leftCombinations)
-		{
-			for (const auto& rc : rightCombinations)
+		return std::make_unique<Evaluation::ProductCombinationStream>(std::move(parts),
+			[mode = m_Mode](const std::vector<Combination>& current, Combination& out)
 			{
+				const int lhs = current[0].TotalValue;
+				const int rhs = current[1].TotalValue;
 				bool comparisonResult = false;
-				switch (m_Mode)
+				switch (mode)
 				{
 					case Mode::LessThan:
-						comparisonResult = (lc.TotalValue < rc.TotalValue);
+						comparisonResult = (lhs < rhs);
 						break;
 					case Mode::LessThanOrEqual:
-						comparisonResult = (lc.TotalValue <= rc.TotalValue);
+						comparisonResult = (lhs <= rhs);
 						break;
 					case Mode::Equal:
-						comparisonResult = (lc.TotalValue == rc.TotalValue);
+						comparisonResult = (lhs == rhs);
 						break;
 					case Mode::NotEqual:
-						comparisonResult = (lc.TotalValue != rc.TotalValue);
+						comparisonResult = (lhs != rhs);
 						break;
 					case Mode::GreaterThanOrEqual:
-						comparisonResult = (lc.TotalValue >= rc.TotalValue);
+						comparisonResult = (lhs >= rhs);
 						break;
 					case Mode::GreaterThan:
-						comparisonResult = (lc.TotalValue > rc.TotalValue);
+						comparisonResult = (lhs > rhs);
 						break;
 					default:
 						throw std::runtime_error("Invalid comparison mode.");
 				}
 
-				Combination combined;
-				combined.TotalValue = comparisonResult ? 1 : 0;
-				combined.Rolls = lc.Rolls;
-				combined.Rolls.insert(combined.Rolls.end(), rc.Rolls.begin(), rc.Rolls.end());
-
-				result.push_back(std::move(combined));
-			}
-		}
-
-		return result;
+				out.TotalValue = comparisonResult ? 1 : 0;
+			});
 	}
 
 	bool Comparison::IsEqual(const DiceOperator& other) const
@@ -187,4 +200,9 @@ namespace DiceCalculator::Operators
 		}
 		return false;
 	}
+
+	std::size_t Comparison::GetHash() const
+	{
+		return HashCombine(DiceOperator::GetHash(), static_cast<std::size_t>(m_Mode));
+	}
 }
\ No newline at end of file
@@ -3,70 +3,59 @@
 
 namespace DiceCalculator::Operators
 {
-	bool Subtraction::Validate(std::vector<std::shared_ptr<DiceCalculator::Expressions::DiceAst>> operands) const
+	bool Subtraction::Validate(Operands operands) const
 	{
 		// Require at least one operand (unary minus is supported as subtracting nothing)
 		return operands.size() >= 1;
 	}
 
-	int Subtraction::Evaluate(DiceCalculator::Evaluation::RollAstVisitor& visitor, std::vector<std::shared_ptr<DiceCalculator::Expressions::DiceAst>> operands) const
+	int Subtraction::Evaluate(DiceCalculator::Evaluation::RollAstVisitor& visitor, Operands operands) const
 	{
 		if (operands.empty())
 		{
 			return 0;
 		}
 
-		std::vector<DiceCalculator::Evaluation::RollAstVisitor::DiceRollRecord> totalRecords;
-
 		operands[0]->Accept(visitor);
 		int total = visitor.GetResult();
-		const auto& records = visitor.GetDiceRecords();
-		totalRecords.insert(totalRecords.end(), records.begin(), records.end());
+		auto dice = visitor.TakeDice();
 
 		for (size_t i = 1; i < operands.size(); ++i)
 		{
 			operands[i]->Accept(visitor);
 			total -= visitor.GetResult();
-			const auto& records = visitor.GetDiceRecords();
-			totalRecords.insert(totalRecords.end(), records.begin(), records.end());
+			visitor.AppendDice(dice);
 		}
-		visitor.SetDiceRecords(totalRecords);
+		visitor.SetDice(std::move(dice));
 
 		return total;
 	}
 
-	Distribution Subtraction::Evaluate(DiceCalculator::Evaluation::ConvolutionAstVisitor& visitor, std::vector<std::shared_ptr<DiceCalculator::Expressions::DiceAst>> operands) const
+	std::uint32_t Subtraction::Compile(DiceCalculator::Evaluation::RollProgramCompiler& compiler, Operands operands) const
 	{
 		if (operands.empty())
 		{
-			return Distribution();
+			return compiler.Emit(Evaluation::RollProgram::OpCode::Constant, 0, 0);
 		}
 
-		// Start with the distribution of the first operand
-		operands[0]->Accept(visitor);
-		Distribution totalDistribution = visitor.GetDistribution();
-
-		// For every subsequent operand, convolve by subtracting its distribution
-		for (size_t i = 1; i < operands.size(); ++i)
+		std::uint32_t total = compiler.CompileOperand(*operands[0]);
+		for (std::size_t i = 1; i < operands.size(); ++i)
 		{
-			operands[i]->Accept(visitor);
-			const Distribution& opDistribution = visitor.GetDistribution();
+			const std::uint32_t operand = compiler.CompileOperand(*operands[i]);
+			total = compiler.Emit(Evaluation::RollProgram::OpCode::Subtract, static_cast<std::int32_t>(total), static_cast<std::int32_t>(operand));
+		}
+		return total;
+	}
 
-			Distribution newTotalDistribution;
-			// Combine the current total distribution with the new operand distribution (subtraction)
-			for (const auto& [totalValue, totalProb] : totalDistribution)
-			{
-				for (const auto& [opValue, opProb] : opDistribution)
-				{
-					int newValue = totalValue - opValue;
-					double newProb = totalProb * opProb;
-					newTotalDistribution[newValue] += newProb;
-				}
-			}
-			totalDistribution = std::move(newTotalDistribution);
+	Distribution Subtraction::Evaluate(DiceCalculator::Evaluation::ConvolutionAstVisitor& visitor, Operands operands) const
+	{
+		if (operands.empty())
+		{
+			return Distribution();
 		}
 
-		return totalDistribution;
+		// a - b - c - ... = a + (-b) + (-c) + ...
+		return visitor.EvaluateSum(operands.first(1), operands.subspan(1));
 	}
 
 	bool Subtraction::IsEqual(const DiceOperator& other) const
@@ -74,46 +63,31 @@ namespace DiceCalculator::Operators
 		return dynamic_cast<const Subtraction*>(&other) != nullptr;
 	}
 
-	std::vector<Combination> Subtraction::Evaluate(DiceCalculator::Evaluation::CombinationAstVisitor& visitor, std::vector<std::shared_ptr<DiceCalculator::Expressions::DiceAst>> operands) const
+	std::unique_ptr<DiceCalculator::Evaluation::CombinationStream> Subtraction::Evaluate(DiceCalculator::Evaluation::CombinationAstVisitor& visitor, Operands operands) const
 	{
 		if (operands.empty())
 		{
-			return {};
+			return std::make_unique<Evaluation::ListCombinationStream>(std::vector<Combination>{});
 		}
 
-		// Start with combinations of the first operand
-		operands[0]->Accept(visitor);
-		std::vector<Combination> total = visitor.GetCombinations();
-
-		// Subtract subsequent operands' totals, concatenating their rolls
-		for (size_t i = 1; i < operands.size(); ++i)
+		std::vector<std::unique_ptr<Evaluation::CombinationStream>> parts;
+		parts.reserve(operands.size());
+		for (auto& op : operands)
 		{
-			operands[i]->Accept(visitor);
-			const auto& opCombinations = visitor.GetCombinations();
-
-			std::vector<Combination> newTotal;
-			newTotal.reserve(static_cast<size_t>(total.size()) * static_cast<size_t>(opCombinations.size()));
+			op->Accept(visitor);
+			parts.push_back(visitor.TakeStream());
+		}
 
-			for (const auto& t : total)
+		// Subtract subsequent operands' totals from the first, concatenating their rolls
+		return std::make_unique<Evaluation::ProductCombinationStream>(std::move(parts),
+			[](const std::vector<Combination>& current, Combination& out)
 			{
-				for (const auto& oc : opCombinations)
+				out.TotalValue = current[0].TotalValue;
+				for (size_t i = 1; i < current.size(); ++i)
 				{
-					Combination combined;
-					combined.TotalValue = t.TotalValue - oc.TotalValue;
-					combined.Rolls = t.Rolls;
-					combined.Rolls.insert(combined.Rolls.end(), oc.Rolls.begin(), oc.Rolls.end());
-					newTotal.push_back(std::move(combined));
-					if (newTotal.size() > DiceCalculator::Evaluation::CombinationAstVisitor::MaxCombinationsThreshold)
-					{
-						throw std::runtime_error("Roll evaluation exceeded maximum allowed dice rolls.");
-					}
+					out.TotalValue -= current[i].TotalValue;
 				}
-			}
-
-			total = std::move(newTotal);
-		}
-
-		return total;
+			});
 	}
 
 	std::vector<RegistryEntry> Subtraction::Register()
@@ -5,6 +5,7 @@
 #include "DiceCalculator/Expressions/ConstantNode.h"
 #include "DiceCalculator/Expressions/DiceNode.h"
 #include "DiceCalculator/Expressions/OperatorNode.h"
+#include "DiceCalculator/Expressions/AstFactory.h"
 
 #include "DiceCalculator/Operators/Addition.h"
 #include "DiceCalculator/Operators/Subtraction.h"
@@ -18,6 +19,7 @@
 
 #include <string>
 #include <memory>
+#include <mutex>
 
 namespace DiceCalculator::Parsing
 {
@@ -31,48 +33,49 @@ namespace DiceCalculator::Parsing
 
 	namespace
 	{
-		// helper creators used in semantic actions
-		static DiceAstPtr MakeConstant(int value)
+		// helper creators used in semantic actions; all nodes go through the factory so that repeated
+		// subexpressions (and backtracked alternatives) share one node
+		static DiceAstPtr MakeConstant(AstFactory& factory, int value)
 		{
-			return std::make_shared<ConstantNode>(value);
+			return factory.MakeConstant(value);
 		}
 
-		static DiceAstPtr MakeDice(int rolls, int sides)
+		static DiceAstPtr MakeDice(AstFactory& factory, int rolls, int sides)
 		{
-			return std::make_shared<DiceNode>(rolls, sides);
+			return factory.MakeDice(rolls, sides);
 		}
 
-		static DiceAstPtr MakeBinaryOp(std::shared_ptr<DiceOperator> op, DiceAstPtr left, DiceAstPtr right)
+		static DiceAstPtr MakeBinaryOp(AstFactory& factory, std::shared_ptr<DiceOperator> op, DiceAstPtr left, DiceAstPtr right)
 		{
-			return std::make_shared<OperatorNode>(op, std::vector<DiceAstPtr>{ left, right });
+			return factory.MakeOperator(op, std::vector<DiceAstPtr>{ left, right });
 		}
 
-		static DiceAstPtr MakeAddition(DiceAstPtr left, DiceAstPtr right)
+		static DiceAstPtr MakeAddition(AstFactory& factory, DiceAstPtr left, DiceAstPtr right)
 		{
-			return MakeBinaryOp(std::make_shared<Addition>(), left, right);
+			return MakeBinaryOp(factory, std::make_shared<Addition>(), left, right);
 		}
 
-		static DiceAstPtr MakeSubtraction(DiceAstPtr left, DiceAstPtr right)
+		static DiceAstPtr MakeSubtraction(AstFactory& factory, DiceAstPtr left, DiceAstPtr right)
 		{
-			return MakeBinaryOp(std::make_shared<Subtraction>(), left, right);
+			return MakeBinaryOp(factory, std::make_shared<Subtraction>(), left, right);
 		}
 
-		static DiceAstPtr MakeAdvantage(DiceAstPtr operand)
+		static DiceAstPtr MakeAdvantage(AstFactory& factory, DiceAstPtr operand)
 		{
-			return std::make_shared<OperatorNode>(std::make_shared<Advantage>(Advantage::Mode::Advantage), std::vector<DiceAstPtr>{ operand });
+			return factory.MakeOperator(std::make_shared<Advantage>(Advantage::Mode::Advantage), std::vector<DiceAstPtr>{ operand });
 		}
 
-		static DiceAstPtr MakeComparison(Comparison::Mode mode, DiceAstPtr left, DiceAstPtr right)
+		static DiceAstPtr MakeComparison(AstFactory& factory, Comparison::Mode mode, DiceAstPtr left, DiceAstPtr right)
 		{
-			return std::make_shared<OperatorNode>(std::make_shared<Comparison>(mode), std::vector<DiceAstPtr>{ left, right });
+			return factory.MakeOperator(std::make_shared<Comparison>(mode), std::vector<DiceAstPtr>{ left, right });
 		}
 
-		static DiceAstPtr MakeAttackRoll(DiceAstPtr left, DiceAstPtr right)
+		static DiceAstPtr MakeAttackRoll(AstFactory& factory, DiceAstPtr left, DiceAstPtr right)
 		{
-			return std::make_shared<OperatorNode>(std::make_shared<AttackRoll>(), std::vector<DiceAstPtr>{ left, right });
+			return factory.MakeOperator(std::make_shared<AttackRoll>(), std::vector<DiceAstPtr>{ left, right });
 		}
 
-		static DiceAstPtr MakeFunction(std::shared_ptr<IRegistry> registry, const std::string& name, const std::vector<DiceAstPtr>& args)
+		static DiceAstPtr MakeFunction(AstFactory& factory, std::shared_ptr<IRegistry> registry, const std::string& name, const std::vector<DiceAstPtr>& args)
 		{
 			for (const auto& arg : args)
 			{
@@ -83,10 +86,10 @@ namespace DiceCalculator::Parsing
 			}
 
 			auto opEntry = registry->GetEntry(name, Operators::Arity::Function);
-			return std::make_shared<OperatorNode>(opEntry.FactoryFunc(), args);
+			return factory.MakeOperator(opEntry.FactoryFunc(), args);
 		}
 
-		static DiceAstPtr MakeOperator(std::shared_ptr<IRegistry> registry, const std::string& name, const std::vector<DiceAstPtr>& args)
+		static DiceAstPtr MakeOperator(AstFactory& factory, std::shared_ptr<IRegistry> registry, const std::string& name, const std::vector<DiceAstPtr>& args)
 		{
 			for (const auto& arg : args)
 			{
@@ -104,10 +107,11 @@ namespace DiceCalculator::Parsing
 			auto arity = static_cast<Arity>(args.size());
 			auto opEntry = registry->GetEntry(name, arity);
 			
-			return std::make_shared<OperatorNode>(opEntry.FactoryFunc(), args);
+			return factory.MakeOperator(opEntry.FactoryFunc(), args);
 		}
 
 		static DiceAstPtr MakeBinaryOperator(
+			AstFactory& factory,
 			std::shared_ptr<IRegistry> registry,
 			const std::string& name,
 			const DiceAstPtr& lhs,
@@ -116,102 +120,136 @@ namespace DiceCalculator::Parsing
 			std::vector<DiceAstPtr> args;
 			args.push_back(lhs);
 			args.push_back(rhs);
-			return MakeOperator(registry, name, args);
+			return MakeOperator(factory, registry, name, args);
 		}
 
 	}
 
-	BoostSpiritParser::BoostSpiritParser(std::shared_ptr<Operators::IRegistry> registry):
-		m_Registry(std::move(registry))
+	// The rules reference each other by address, so a grammar is never copied or moved; the parser holds
+	// it through a shared_ptr. Parsing only reads the rules and the symbol table and keeps all attributes
+	// on the caller's stack, so one grammar can serve concurrent parses.
+	struct BoostSpiritParser::Grammar
 	{
+		using Iterator = std::string::const_iterator;
 
-	}
+		Grammar(std::shared_ptr<IRegistry> registry, std::shared_ptr<AstFactory> astFactory) :
+			Factory(std::move(astFactory))
+		{
+			AstFactory& factory = *Factory;
 
-	std::shared_ptr<DiceCalculator::Expressions::DiceAst> BoostSpiritParser::Parse(const std::string& input) const
-	{
-		using Iterator = std::string::const_iterator;
+			argumentList =
+				expression % ',';
 
-		// qi placeholders
-		qi::rule<Iterator, DiceAstPtr(), ascii::space_type> expression;
-		qi::rule<Iterator, DiceAstPtr(), ascii::space_type> additive;
-		qi::rule<Iterator, DiceAstPtr(), ascii::space_type> primary;
-		qi::rule<Iterator, std::string(), ascii::space_type> identifier;
-		qi::rule<Iterator, std::vector<DiceAstPtr>(), ascii::space_type> argumentList;
-		qi::rule<Iterator, DiceAstPtr(), ascii::space_type> functionCall;
+			identifier =
+				qi::lexeme[
+					qi::alpha >> *(qi::alnum | qi::char_('_'))
+				];
 
-		argumentList =
-			expression % ',';
+			functionCall =
+				(identifier >> '(' >> argumentList >> ')')
+				[
+					qi::_val = phoenix::bind(&MakeFunction, phoenix::ref(factory), registry, qi::_1, qi::_2)
+				];
 
-		identifier =
-			qi::lexeme[
-				qi::alpha >> *(qi::alnum | qi::char_('_'))
-			];
+			// primary: dice, number, ADV(...), parenthesized expression
+			primary =
+				(qi::int_ >> qi::lit('d') >> qi::int_)
+				[qi::_val = phoenix::bind(&MakeDice, phoenix::ref(factory), qi::_1, qi::_2)]
 
-		functionCall =
-			(identifier >> '(' >> argumentList >> ')')
-			[
-				qi::_val = phoenix::bind(&MakeFunction, m_Registry, qi::_1, qi::_2)
-			];
+				| (qi::int_)
+				[qi::_val = phoenix::bind(&MakeConstant, phoenix::ref(factory), qi::_1)]
 
-		// primary: dice, number, ADV(...), parenthesized expression
-		primary =
-			(qi::int_ >> qi::lit('d') >> qi::int_)
-			[qi::_val = phoenix::bind(&MakeDice, qi::_1, qi::_2)]
+				| functionCall[qi::_val = qi::_1]
 
-			| (qi::int_)
-			[qi::_val = phoenix::bind(&MakeConstant, qi::_1)]
+				| ('(' >> expression >> ')')
+				[qi::_val = qi::_1]
+				;
 
-			| functionCall[qi::_val = qi::_1]
+			// additive: left-associative chain of registered binary operators
+			auto binaryOperatorEntries = registry->GetOperatorsByArity(Arity::Binary);
+			assert(binaryOperatorEntries.size() > 0 && "No binary operators registered.");
+			for (const auto& entry : binaryOperatorEntries)
+			{
+				// Register operator symbol (e.g., "+", "-") mapped to its name
+				binaryOps.add(entry.Name, entry.Name);
+			}
 
-			| ('(' >> expression >> ')')
-			[qi::_val = qi::_1]
-			;
+			additive =
+				primary
+				[qi::_val = qi::_1]
+				>> *(
+					(binaryOps >> primary)
+					[
+						qi::_val = phoenix::bind(
+							&MakeBinaryOperator,
+							phoenix::ref(factory),
+							registry,
+							qi::_1,    // operator name from registry
+							qi::_val,  // current accumulated lhs
+							qi::_2     // rhs
+						)
+					]
+				);
+
+
+			// comparison: support comparison operators. Use qi::lit to suppress operator attributes
+			// Produce either a comparison node (left op right) or the additive AST when no comparison.
+			expression =
+				  (additive >> (qi::lit(">=") >> additive))[ qi::_val = phoenix::bind(&MakeComparison, phoenix::ref(factory), Comparison::Mode::GreaterThanOrEqual, qi::_1, qi::_2) ]
+				| (additive >> (qi::lit("<=") >> additive))[ qi::_val = phoenix::bind(&MakeComparison, phoenix::ref(factory), Comparison::Mode::LessThanOrEqual, qi::_1, qi::_2) ]
+				| (additive >> (qi::lit(">")  >> additive))[ qi::_val = phoenix::bind(&MakeComparison, phoenix::ref(factory), Comparison::Mode::GreaterThan, qi::_1, qi::_2) ]
+				| (additive >> (qi::lit("<")  >> additive))[ qi::_val = phoenix::bind(&MakeComparison, phoenix::ref(factory), Comparison::Mode::LessThan, qi::_1, qi::_2) ]
+				| (additive >> (qi::lit("==") >> additive))[ qi::_val = phoenix::bind(&MakeComparison, phoenix::ref(factory), Comparison::Mode::Equal, qi::_1, qi::_2) ]
+				| (additive >> (qi::lit("!=") >> additive))[ qi::_val = phoenix::bind(&MakeComparison, phoenix::ref(factory), Comparison::Mode::NotEqual, qi::_1, qi::_2) ]
+				| additive[ qi::_val = qi::_1 ]
+				;
+
+			start = expression >> qi::eoi;
+		}
 
-		// additive: left-associative chain of registered binary operators
+		Grammar(const Grammar&) = delete;
+		Grammar& operator=(const Grammar&) = delete;
+
+		std::shared_ptr<AstFactory> Factory;
+
+		qi::rule<Iterator, DiceAstPtr(), ascii::space_type> start;
+		qi::rule<Iterator, DiceAstPtr(), ascii::space_type> expression;
+		qi::rule<Iterator, DiceAstPtr(), ascii::space_type> additive;
+		qi::rule<Iterator, DiceAstPtr(), ascii::space_type> primary;
+		qi::rule<Iterator, std::string(), ascii::space_type> identifier;
+		qi::rule<Iterator, std::vector<DiceAstPtr>(), ascii::space_type> argumentList;
+		qi::rule<Iterator, DiceAstPtr(), ascii::space_type> functionCall;
 		qi::symbols<char, std::string> binaryOps;
-		auto binaryOperatorEntries = m_Registry->GetOperatorsByArity(Arity::Binary);
-		assert(binaryOperatorEntries.size() > 0 && "No binary operators registered.");
-		for (const auto& entry : binaryOperatorEntries)
+	};
+
+	BoostSpiritParser::BoostSpiritParser(std::shared_ptr<Operators::IRegistry> registry):
+		m_Registry(std::move(registry)), m_Factory(std::make_shared<AstFactory>())
+	{
+
+	}
+
+	std::shared_ptr<const BoostSpiritParser::Grammar> BoostSpiritParser::GetGrammar() const
+	{
+		std::lock_guard lock(m_GrammarMutex);
+		const std::size_t version = m_Registry->GetVersion();
+		if (!m_Grammar || m_GrammarVersion != version)
 		{
-			// Register operator symbol (e.g., "+", "-") mapped to its name
-			binaryOps.add(entry.Name, entry.Name);
+			m_Grammar = std::make_shared<const Grammar>(m_Registry, m_Factory);
+			m_GrammarVersion = version;
 		}
+		return m_Grammar;
+	}
 
-		additive =
-			primary
-			[qi::_val = qi::_1]
-			>> *(
-				(binaryOps >> primary)
-				[
-					qi::_val = phoenix::bind(
-						&MakeBinaryOperator,
-						m_Registry,
-						qi::_1,    // operator name from registry
-						qi::_val,  // current accumulated lhs
-						qi::_2     // rhs
-					)
-				]
-			);
-
-
-		// comparison: support comparison operators. Use qi::lit to suppress operator attributes
-		// Produce either a comparison node (left op right) or the additive AST when no comparison.
-		expression =
-			  (additive >> (qi::lit(">=") >> additive))[ qi::_val = phoenix::bind(&MakeComparison, Comparison::Mode::GreaterThanOrEqual, qi::_1, qi::_2) ]
-			| (additive >> (qi::lit("<=") >> additive))[ qi::_val = phoenix::bind(&MakeComparison, Comparison::Mode::LessThanOrEqual, qi::_1, qi::_2) ]
-			| (additive >> (qi::lit(">")  >> additive))[ qi::_val = phoenix::bind(&MakeComparison, Comparison::Mode::GreaterThan, qi::_1, qi::_2) ]
-			| (additive >> (qi::lit("<")  >> additive))[ qi::_val = phoenix::bind(&MakeComparison, Comparison::Mode::LessThan, qi::_1, qi::_2) ]
-			| (additive >> (qi::lit("==") >> additive))[ qi::_val = phoenix::bind(&MakeComparison, Comparison::Mode::Equal, qi::_1, qi::_2) ]
-			| (additive >> (qi::lit("!=") >> additive))[ qi::_val = phoenix::bind(&MakeComparison, Comparison::Mode::NotEqual, qi::_1, qi::_2) ]
-			| additive[ qi::_val = qi::_1 ]
-			;
-
-		Iterator begin = input.begin();
-		Iterator end = input.end();
+	std::shared_ptr<DiceCalculator::Expressions::DiceAst> BoostSpiritParser::Parse(const std::string& input) const
+	{
+		const auto grammar = GetGrammar();
+
+		Grammar::Iterator begin = input.begin();
+		Grammar::Iterator end = input.end();
 		DiceAstPtr result;
 
 		bool ok = qi::phrase_parse(begin, end,
-			expression >> qi::eoi, // grammar
+			grammar->start,        // grammar
 			ascii::space,          // skipper
 			result                 // synthesized attribute
 		);
@@ -289,9 +327,16 @@ namespace DiceCalculator::Parsing
 			{
 				if (op->IsEqual(*entry.FactoryFunc()))
 				{
-					std::string lhs = ReconstructInternal(operands[0], true);
-					std::string rhs = ReconstructInternal(operands[1], true);
-					std::string result = lhs + " " + entry.Name + " " + rhs;
+					// Flattened n-ary chains are written out as a + b + c.
+					std::string result;
+					for (size_t i = 0; i < operands.size(); ++i)
+					{
+						if (i > 0)
+						{
+							result += " " + entry.Name + " ";
+						}
+						result += ReconstructInternal(operands[i], true);
+					}
 					return isChildOfOperator ? "(" + result + ")" : result;
 				}
 			}
@@ -0,0 +1,95 @@
+#include "DiceCalculator/PhiloxRandom.h"
+
+#include <stdexcept>
+
+namespace DiceCalculator
+{
+	namespace
+	{
+		constexpr std::uint32_t PhiloxM0 = 0xD2511F53u;
+		constexpr std::uint32_t PhiloxM1 = 0xCD9E8D57u;
+		constexpr std::uint32_t PhiloxW0 = 0x9E3779B9u;
+		constexpr std::uint32_t PhiloxW1 = 0xBB67AE85u;
+		constexpr int PhiloxRounds = 10;
+	}
+
+	PhiloxRandom::PhiloxRandom(std::uint64_t seed, std::uint64_t stream) :
+		m_Key{ static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32) },
+		m_Counter{ 0, 0, static_cast<std::uint32_t>(stream), static_cast<std::uint32_t>(stream >> 32) }
+	{
+	}
+
+	PhiloxRandom::Counter PhiloxRandom::Generate(Counter counter, Key key)
+	{
+		for (int round = 0; round < PhiloxRounds; ++round)
+		{
+			const std::uint64_t product0 = static_cast<std::uint64_t>(PhiloxM0) * counter[0];
+			const std::uint64_t product1 = static_cast<std::uint64_t>(PhiloxM1) * counter[2];
+			counter = {
+				static_cast<std::uint32_t>(product1 >> 32) ^ counter[1] ^ key[0],
+				static_cast<std::uint32_t>(product1),
+				static_cast<std::uint32_t>(product0 >> 32) ^ counter[3] ^ key[1],
+				static_cast<std::uint32_t>(product0)
+			};
+			key[0] += PhiloxW0;
+			key[1] += PhiloxW1;
+		}
+		return counter;
+	}
+
+	std::uint32_t PhiloxRandom::NextUInt32()
+	{
+		if (m_BlockPosition == m_Block.size())
+		{
+			m_Block = Generate(m_Counter, m_Key);
+			m_BlockPosition = 0;
+			if (++m_Counter[0] == 0)
+			{
+				++m_Counter[1];
+			}
+		}
+		return m_Block[m_BlockPosition++];
+	}
+
+	std::uint32_t PhiloxRandom::NextBelow(std::uint32_t range)
+	{
+		if (range == 0)
+		{
+			return NextUInt32();
+		}
+
+		// Values at or above the largest multiple of `range` would over-represent the low results.
+		const std::uint32_t limit = static_cast<std::uint32_t>(0x100000000ull - 0x100000000ull % range);
+		std::uint32_t value = NextUInt32();
+		while (limit != 0 && value >= limit)
+		{
+			value = NextUInt32();
+		}
+		return value % range;
+	}
+
+	int PhiloxRandom::NextInt(int minInclusive, int maxInclusive)
+	{
+		if (maxInclusive < minInclusive)
+		{
+			throw std::invalid_argument("PhiloxRandom::NextInt requires minInclusive <= maxInclusive.");
+		}
+
+		const std::uint32_t range = static_cast<std::uint32_t>(maxInclusive) - static_cast<std::uint32_t>(minInclusive) + 1u;
+		return static_cast<int>(static_cast<std::uint32_t>(minInclusive) + NextBelow(range));
+	}
+
+	void PhiloxRandom::Fill(std::span<int> out, int minInclusive, int maxInclusive)
+	{
+		if (maxInclusive < minInclusive)
+		{
+			throw std::invalid_argument("PhiloxRandom::Fill requires minInclusive <= maxInclusive.");
+		}
+
+		const std::uint32_t range = static_cast<std::uint32_t>(maxInclusive) - static_cast<std::uint32_t>(minInclusive) + 1u;
+		for (int& value : out)
+		{
+			value = static_cast<int>(static_cast<std::uint32_t>(minInclusive) + NextBelow(range));
+		}
+	}
+}
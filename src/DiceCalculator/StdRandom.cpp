@@ -13,4 +13,13 @@ namespace DiceCalculator
 		std::uniform_int_distribution<> distrib(minInclusive, maxInclusive);
 		return distrib(m_Generator);
 	}
-}
\ No newline at end of file
+
+	void StdRandom::Fill(std::span<int> out, int minInclusive, int maxInclusive)
+	{
+		std::uniform_int_distribution<> distrib(minInclusive, maxInclusive);
+		for (int& value : out)
+		{
+			value = distrib(m_Generator);
+		}
+	}
+}
@@ -0,0 +1,205 @@
+#include "DiceCalculator/ThreadPool.h"
+
+#include <algorithm>
+#include <exception>
+
+namespace DiceCalculator
+{
+	namespace
+	{
+		// Lets Submit and TryRunOne find the calling worker's own deque.
+		thread_local const ThreadPool* t_CurrentPool = nullptr;
+		thread_local std::size_t t_WorkerIndex = 0;
+	}
+
+	ThreadPool::ThreadPool(std::size_t threadCount)
+	{
+		if (threadCount == 0)
+		{
+			threadCount = std::max(1u, std::thread::hardware_concurrency());
+		}
+
+		// One deque per worker plus the injection queue at the end.
+		for (std::size_t i = 0; i <= threadCount; ++i)
+		{
+			m_Queues.push_back(std::make_unique<WorkQueue>());
+		}
+
+		m_Threads.reserve(threadCount);
+		for (std::size_t i = 0; i < threadCount; ++i)
+		{
+			m_Threads.emplace_back([this, i]() { WorkerLoop(i); });
+		}
+	}
+
+	ThreadPool::~ThreadPool()
+	{
+		{
+			std::lock_guard lock(m_SleepMutex);
+			m_Stopping = true;
+		}
+		m_WakeUp.notify_all();
+
+		for (auto& thread : m_Threads)
+		{
+			thread.join();
+		}
+	}
+
+	void ThreadPool::Submit(std::function<void()> task)
+	{
+		const std::size_t queueIndex = t_CurrentPool == this ? t_WorkerIndex : GetInjectionQueue();
+		{
+			std::lock_guard lock(m_Queues[queueIndex]->Mutex);
+			m_Queues[queueIndex]->Tasks.push_back(std::move(task));
+		}
+
+		{
+			std::lock_guard lock(m_SleepMutex);
+			++m_Pending;
+		}
+		m_WakeUp.notify_one();
+	}
+
+	void ThreadPool::ForEach(std::size_t count, const std::function<void(std::size_t)>& body)
+	{
+		if (count == 0)
+		{
+			return;
+		}
+
+		// Queued tasks may outlive this call once every index has been claimed, so they share the
+		// batch state and only touch `body` after claiming an index.
+		struct Batch
+		{
+			std::atomic<std::size_t> Next = 0;
+			std::size_t Count = 0;
+			const std::function<void(std::size_t)>* Body = nullptr;
+
+			std::mutex Mutex;
+			std::condition_variable Done;
+			std::size_t Remaining = 0;
+			std::exception_ptr Error;
+		};
+
+		auto batch = std::make_shared<Batch>();
+		batch->Count = count;
+		batch->Body = &body;
+		batch->Remaining = count;
+
+		auto runClaimed = [](Batch& batch)
+			{
+				for (std::size_t index = batch.Next++; index < batch.Count; index = batch.Next++)
+				{
+					std::exception_ptr error;
+					try
+					{
+						(*batch.Body)(index);
+					}
+					catch (...)
+					{
+						error = std::current_exception();
+					}
+
+					std::lock_guard lock(batch.Mutex);
+					if (error && !batch.Error)
+					{
+						batch.Error = error;
+					}
+					if (--batch.Remaining == 0)
+					{
+						batch.Done.notify_all();
+					}
+				}
+			};
+
+		for (std::size_t i = 1; i < count; ++i)
+		{
+			Submit([batch, runClaimed]() { runClaimed(*batch); });
+		}
+		runClaimed(*batch);
+
+		// Every index is claimed and running on some thread, so waiting cannot deadlock. Running other
+		// queued tasks here could instead pick up an outer task that waits on this very call.
+		std::unique_lock lock(batch->Mutex);
+		batch->Done.wait(lock, [&]() { return batch->Remaining == 0; });
+		if (batch->Error)
+		{
+			std::rethrow_exception(batch->Error);
+		}
+	}
+
+	void ThreadPool::WorkerLoop(std::size_t index)
+	{
+		t_CurrentPool = this;
+		t_WorkerIndex = index;
+
+		while (true)
+		{
+			if (TryRunOne())
+			{
+				continue;
+			}
+
+			std::unique_lock lock(m_SleepMutex);
+			m_WakeUp.wait(lock, [this]() { return m_Stopping || m_Pending > 0; });
+			if (m_Stopping && m_Pending == 0)
+			{
+				return;
+			}
+		}
+	}
+
+	bool ThreadPool::TryRunOne()
+	{
+		auto task = TryTake(t_CurrentPool == this ? t_WorkerIndex : GetInjectionQueue());
+		if (!task)
+		{
+			return false;
+		}
+
+		task();
+		return true;
+	}
+
+	std::function<void()> ThreadPool::TryTake(std::size_t ownQueue)
+	{
+		std::function<void()> task;
+
+		// Newest own task first: it is the most likely to still be in cache.
+		if (ownQueue != GetInjectionQueue())
+		{
+			std::lock_guard lock(m_Queues[ownQueue]->Mutex);
+			auto& tasks = m_Queues[ownQueue]->Tasks;
+			if (!tasks.empty())
+			{
+				task = std::move(tasks.back());
+				tasks.pop_back();
+			}
+		}
+
+		// Otherwise take the oldest task of the next queue that has one, the injection queue included.
+		for (std::size_t offset = 1; !task && offset <= m_Queues.size(); ++offset)
+		{
+			const std::size_t victim = (ownQueue + offset) % m_Queues.size();
+			if (victim == ownQueue && ownQueue != GetInjectionQueue())
+			{
+				continue;
+			}
+
+			std::lock_guard lock(m_Queues[victim]->Mutex);
+			auto& tasks = m_Queues[victim]->Tasks;
+			if (!tasks.empty())
+			{
+				task = std::move(tasks.front());
+				tasks.pop_front();
+			}
+		}
+
+		if (task)
+		{
+			--m_Pending;
+		}
+		return task;
+	}
+}
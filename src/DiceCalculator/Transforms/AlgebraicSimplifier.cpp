@@ -0,0 +1,230 @@
+#include "DiceCalculator/Transforms/AlgebraicSimplifier.h"
+#include "DiceCalculator/Evaluation/RollAstVisitor.h"
+#include "DiceCalculator/Expressions/ConstantNode.h"
+#include "DiceCalculator/Expressions/DiceNode.h"
+#include "DiceCalculator/Expressions/OperatorNode.h"
+#include "DiceCalculator/Operators/Addition.h"
+#include "DiceCalculator/Operators/Subtraction.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace DiceCalculator::Transforms
+{
+	using DiceAstPtr = std::shared_ptr<DiceCalculator::Expressions::DiceAst>;
+	using namespace DiceCalculator::Expressions;
+	using namespace DiceCalculator::Operators;
+
+	namespace
+	{
+		using SimplifiedNodes = std::unordered_map<const DiceAst*, DiceAstPtr>;
+
+		// Folding only evaluates operators whose operands are all constants, so no die is ever rolled.
+		class NoDiceRandom : public IRandom
+		{
+		public:
+			int NextInt(int, int) override
+			{
+				throw std::logic_error("Constant folding rolled a die.");
+			}
+		};
+
+		// One term of a signed sum. Dice terms have positive Rolls and Sides; Node is replaced by a new
+		// DiceNode once other dice have been pooled into it.
+		struct SumTerm
+		{
+			DiceAstPtr Node;
+			bool Negative = false;
+			int Rolls = 0;
+			int Sides = 0;
+			bool Pooled = false;
+		};
+
+		struct SignedSum
+		{
+			std::vector<SumTerm> Terms;
+			int Constant = 0;
+		};
+
+		bool IsAddition(const OperatorNode& node)
+		{
+			return dynamic_cast<const Addition*>(node.GetOperator().get()) != nullptr;
+		}
+
+		bool IsSubtraction(const OperatorNode& node)
+		{
+			return dynamic_cast<const Subtraction*>(node.GetOperator().get()) != nullptr;
+		}
+
+		DiceAstPtr SimplifyShared(const DiceAstPtr& ast, SimplifiedNodes& simplifiedNodes);
+
+		// Adds `ast`, negated if `negative`, to `sum`, descending into nested sums and differences.
+		void CollectTerms(const DiceAstPtr& ast, bool negative, SignedSum& sum, SimplifiedNodes& simplifiedNodes)
+		{
+			if (auto constant = std::dynamic_pointer_cast<const ConstantNode>(ast))
+			{
+				sum.Constant += negative ? -constant->GetValue() : constant->GetValue();
+				return;
+			}
+
+			if (auto dice = std::dynamic_pointer_cast<const DiceNode>(ast); dice && dice->GetRolls() > 0 && dice->GetSides() > 0)
+			{
+				auto pool = std::find_if(sum.Terms.begin(), sum.Terms.end(), [&](const SumTerm& term)
+					{
+						return term.Rolls > 0 && term.Sides == dice->GetSides() && term.Negative == negative;
+					});
+				if (pool != sum.Terms.end())
+				{
+					pool->Rolls += dice->GetRolls();
+					pool->Pooled = true;
+					return;
+				}
+				sum.Terms.push_back(SumTerm{ ast, negative, dice->GetRolls(), dice->GetSides() });
+				return;
+			}
+
+			auto operatorNode = std::dynamic_pointer_cast<const OperatorNode>(ast);
+			if (operatorNode && IsAddition(*operatorNode))
+			{
+				for (const auto& operand : operatorNode->GetOperands())
+				{
+					CollectTerms(operand, negative, sum, simplifiedNodes);
+				}
+				return;
+			}
+			if (operatorNode && IsSubtraction(*operatorNode))
+			{
+				const auto& operands = operatorNode->GetOperands();
+				for (std::size_t i = 0; i < operands.size(); ++i)
+				{
+					CollectTerms(operands[i], i == 0 ? negative : !negative, sum, simplifiedNodes);
+				}
+				return;
+			}
+
+			DiceAstPtr simplified = SimplifyShared(ast, simplifiedNodes);
+			if (simplified != ast)
+			{
+				// Folding may have turned the subtree into a constant.
+				CollectTerms(simplified, negative, sum, simplifiedNodes);
+				return;
+			}
+			sum.Terms.push_back(SumTerm{ ast, negative });
+		}
+
+		// Builds minuend - subtrahends from the collected terms, with the folded constant last.
+		DiceAstPtr BuildSum(const SignedSum& sum)
+		{
+			std::vector<DiceAstPtr> positive;
+			std::vector<DiceAstPtr> negative;
+			for (const SumTerm& term : sum.Terms)
+			{
+				DiceAstPtr node = term.Pooled ? std::make_shared<DiceNode>(term.Rolls, term.Sides) : term.Node;
+				(term.Negative ? negative : positive).push_back(std::move(node));
+			}
+
+			if (sum.Constant > 0 || (sum.Constant < 0 && positive.empty()))
+			{
+				positive.push_back(std::make_shared<ConstantNode>(sum.Constant));
+			}
+			else if (sum.Constant < 0)
+			{
+				negative.push_back(std::make_shared<ConstantNode>(-sum.Constant));
+			}
+			if (positive.empty())
+			{
+				positive.push_back(std::make_shared<ConstantNode>(0));
+			}
+
+			DiceAstPtr minuend = positive.size() == 1 ? positive.front() : std::make_shared<OperatorNode>(std::make_shared<Addition>(), std::move(positive));
+			if (negative.empty())
+			{
+				return minuend;
+			}
+
+			negative.insert(negative.begin(), std::move(minuend));
+			return std::make_shared<OperatorNode>(std::make_shared<Subtraction>(), std::move(negative));
+		}
+
+		// Value of an operator node whose operands are all constants, or null if the operator rejects them;
+		// the error then surfaces when the expression is evaluated.
+		DiceAstPtr FoldConstants(const OperatorNode& node)
+		{
+			const auto& operands = node.GetOperands();
+			const bool allConstant = std::all_of(operands.begin(), operands.end(), [](const DiceAstPtr& operand)
+				{
+					return std::dynamic_pointer_cast<const ConstantNode>(operand) != nullptr;
+				});
+			if (!allConstant || !node.GetOperator()->Validate(operands))
+			{
+				return nullptr;
+			}
+
+			try
+			{
+				NoDiceRandom random;
+				Evaluation::RollAstVisitor visitor(random, Evaluation::RollAstVisitor::Tracking::TotalsOnly);
+				node.Accept(visitor);
+				return std::make_shared<ConstantNode>(visitor.GetResult());
+			}
+			catch (const std::runtime_error&)
+			{
+				return nullptr;
+			}
+		}
+
+		// Subtrees shared within the input (see Expressions::AstFactory) are simplified once and stay shared.
+		DiceAstPtr SimplifyShared(const DiceAstPtr& ast, SimplifiedNodes& simplifiedNodes)
+		{
+			auto operatorNode = std::dynamic_pointer_cast<const OperatorNode>(ast);
+			if (!operatorNode)
+			{
+				return ast;
+			}
+
+			if (auto it = simplifiedNodes.find(ast.get()); it != simplifiedNodes.end())
+			{
+				return it->second;
+			}
+
+			DiceAstPtr result;
+			if (IsAddition(*operatorNode) || IsSubtraction(*operatorNode))
+			{
+				SignedSum sum;
+				CollectTerms(ast, false, sum, simplifiedNodes);
+				result = BuildSum(sum);
+			}
+			else
+			{
+				const auto& operands = operatorNode->GetOperands();
+				bool changed = false;
+				std::vector<DiceAstPtr> simplified;
+				simplified.reserve(operands.size());
+				for (const auto& operand : operands)
+				{
+					simplified.push_back(SimplifyShared(operand, simplifiedNodes));
+					changed |= simplified.back() != operand;
+				}
+
+				auto node = changed ? std::make_shared<OperatorNode>(operatorNode->GetOperator(), std::move(simplified)) : operatorNode;
+				auto folded = FoldConstants(*node);
+				result = folded ? folded : std::const_pointer_cast<OperatorNode>(node);
+			}
+
+			if (result->IsEqual(*ast))
+			{
+				result = ast;
+			}
+			simplifiedNodes.emplace(ast.get(), result);
+			return result;
+		}
+	}
+
+	DiceAstPtr AlgebraicSimplifier::Simplify(const DiceAstPtr& ast)
+	{
+		SimplifiedNodes simplifiedNodes;
+		return SimplifyShared(ast, simplifiedNodes);
+	}
+}
@@ -0,0 +1,80 @@
+#include "DiceCalculator/Transforms/AssociativeFlattener.h"
+#include "DiceCalculator/Expressions/OperatorNode.h"
+#include "DiceCalculator/Operators/Addition.h"
+#include "DiceCalculator/Operators/Subtraction.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace DiceCalculator::Transforms
+{
+	using DiceAstPtr = std::shared_ptr<DiceCalculator::Expressions::DiceAst>;
+	using namespace DiceCalculator::Expressions;
+	using namespace DiceCalculator::Operators;
+
+	namespace
+	{
+		// Which operands of a node with `op` may be spliced into it when they use the same operator:
+		// every operand of a sum, but only the minuend of a difference, since a - (b - c) != a - b - c.
+		bool CanSplice(const DiceOperator& op, std::size_t operandIndex)
+		{
+			if (dynamic_cast<const Addition*>(&op) != nullptr)
+			{
+				return true;
+			}
+			if (dynamic_cast<const Subtraction*>(&op) != nullptr)
+			{
+				return operandIndex == 0;
+			}
+			return false;
+		}
+
+		// Subtrees shared within the input (see Expressions::AstFactory) are flattened once and stay shared.
+		DiceAstPtr FlattenShared(const DiceAstPtr& ast, std::unordered_map<const DiceAst*, DiceAstPtr>& flattenedNodes)
+		{
+			auto operatorNode = std::dynamic_pointer_cast<const OperatorNode>(ast);
+			if (!operatorNode)
+			{
+				return ast;
+			}
+
+			if (auto it = flattenedNodes.find(ast.get()); it != flattenedNodes.end())
+			{
+				return it->second;
+			}
+
+			const auto& op = operatorNode->GetOperator();
+			const auto& operands = operatorNode->GetOperands();
+
+			bool changed = false;
+			std::vector<DiceAstPtr> flattened;
+			flattened.reserve(operands.size());
+			for (std::size_t i = 0; i < operands.size(); ++i)
+			{
+				DiceAstPtr operand = FlattenShared(operands[i], flattenedNodes);
+				changed |= operand != operands[i];
+
+				auto child = std::dynamic_pointer_cast<const OperatorNode>(operand);
+				if (child && CanSplice(*op, i) && op->IsEqual(*child->GetOperator()))
+				{
+					const auto& grandchildren = child->GetOperands();
+					flattened.insert(flattened.end(), grandchildren.begin(), grandchildren.end());
+					changed = true;
+					continue;
+				}
+
+				flattened.push_back(std::move(operand));
+			}
+
+			DiceAstPtr result = changed ? std::make_shared<OperatorNode>(op, std::move(flattened)) : ast;
+			flattenedNodes.emplace(ast.get(), result);
+			return result;
+		}
+	}
+
+	DiceAstPtr AssociativeFlattener::Flatten(const DiceAstPtr& ast)
+	{
+		std::unordered_map<const DiceAst*, DiceAstPtr> flattenedNodes;
+		return FlattenShared(ast, flattenedNodes);
+	}
+}
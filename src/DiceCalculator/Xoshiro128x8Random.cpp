@@ -0,0 +1,96 @@
+#include "DiceCalculator/Xoshiro128x8Random.h"
+#include "DiceCalculator/PhiloxRandom.h"
+
+#include <stdexcept>
+
+namespace DiceCalculator
+{
+	Xoshiro128x8Random::Xoshiro128x8Random(std::uint64_t seed, std::uint64_t stream) :
+		Xoshiro128x8Random(seed, stream, Evaluation::DiceKernels::GetBestSupported())
+	{
+	}
+
+	Xoshiro128x8Random::Xoshiro128x8Random(std::uint64_t seed, std::uint64_t stream, InstructionSet instructionSet) :
+		m_InstructionSet(instructionSet),
+		m_Kernel(Evaluation::DiceKernels::GetRollKernel(instructionSet))
+	{
+		if (m_Kernel == nullptr)
+		{
+			throw std::invalid_argument("Instruction set is not supported on this CPU.");
+		}
+
+		// Lane `lane` starts from Philox block `lane` of stream `stream` under key `seed`. Philox is a
+		// bijection of its counter for a fixed key, so no two lanes of any two streams of one seed share a
+		// starting state, and the key schedule mixes seed and stream non-linearly.
+		const PhiloxRandom::Key key = { static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32) };
+		for (std::size_t lane = 0; lane < Evaluation::DiceKernels::Lanes; ++lane)
+		{
+			const PhiloxRandom::Counter block = PhiloxRandom::Generate(
+				{ static_cast<std::uint32_t>(lane), 0, static_cast<std::uint32_t>(stream), static_cast<std::uint32_t>(stream >> 32) }, key);
+			for (std::size_t word = 0; word < block.size(); ++word)
+			{
+				m_State.Words[word][lane] = block[word];
+			}
+		}
+		for (std::size_t lane = 0; lane < Evaluation::DiceKernels::Lanes; ++lane)
+		{
+			// xoshiro128++ never leaves the all-zero state.
+			if ((m_State.Words[0][lane] | m_State.Words[1][lane] | m_State.Words[2][lane] | m_State.Words[3][lane]) == 0)
+			{
+				m_State.Words[0][lane] = 1;
+			}
+		}
+	}
+
+	int Xoshiro128x8Random::NextInt(int minInclusive, int maxInclusive)
+	{
+		int value = 0;
+		Fill(std::span<int>(&value, 1), minInclusive, maxInclusive);
+		return value;
+	}
+
+	void Xoshiro128x8Random::Fill(std::span<int> out, int minInclusive, int maxInclusive)
+	{
+		if (maxInclusive < minInclusive)
+		{
+			throw std::invalid_argument("Xoshiro128x8Random requires minInclusive <= maxInclusive.");
+		}
+
+		const std::uint32_t range = static_cast<std::uint32_t>(maxInclusive) - static_cast<std::uint32_t>(minInclusive) + 1u;
+		if (range == 0)
+		{
+			// The kernels bound every draw, so the full 32-bit range is drawn as two halves.
+			const std::uint32_t half = 0x10000u;
+			for (int& value : out)
+			{
+				int high = 0;
+				int low = 0;
+				m_Kernel(m_State, 1, half, &high, nullptr, 1);
+				m_Kernel(m_State, 1, half, &low, nullptr, 1);
+				value = static_cast<int>((static_cast<std::uint32_t>(high - 1) << 16) | static_cast<std::uint32_t>(low - 1));
+			}
+			return;
+		}
+
+		m_Kernel(m_State, 1, range, out.data(), nullptr, out.size());
+		const std::uint32_t offset = static_cast<std::uint32_t>(minInclusive) - 1u;
+		for (int& value : out)
+		{
+			value = static_cast<int>(static_cast<std::uint32_t>(value) + offset);
+		}
+	}
+
+	void Xoshiro128x8Random::SumDice(std::span<int> sums, std::span<int> firstFaces, int rolls, int sides)
+	{
+		if (sides < 1)
+		{
+			throw std::invalid_argument("Dice must have at least one side.");
+		}
+		if (!firstFaces.empty() && firstFaces.size() < sums.size())
+		{
+			throw std::invalid_argument("firstFaces must be empty or as long as sums.");
+		}
+
+		m_Kernel(m_State, rolls, static_cast<std::uint32_t>(sides), sums.data(), firstFaces.empty() ? nullptr : firstFaces.data(), sums.size());
+	}
+}
@@ -0,0 +1,127 @@
+#include "DiceCalculator/Xoshiro256Random.h"
+
+#include <bit>
+#include <stdexcept>
+
+namespace DiceCalculator
+{
+	namespace
+	{
+		std::uint64_t SplitMix64(std::uint64_t& state)
+		{
+			std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+			z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+			z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+			return z ^ (z >> 31);
+		}
+
+		// Number of values in [minInclusive, maxInclusive]; 0 stands for the full 2^32 range.
+		std::uint32_t GetRange(int minInclusive, int maxInclusive)
+		{
+			if (maxInclusive < minInclusive)
+			{
+				throw std::invalid_argument("Xoshiro256Random requires minInclusive <= maxInclusive.");
+			}
+			return static_cast<std::uint32_t>(maxInclusive) - static_cast<std::uint32_t>(minInclusive) + 1u;
+		}
+	}
+
+	Xoshiro256Random::Xoshiro256Random(std::uint64_t seed)
+	{
+		for (std::uint64_t& word : m_State)
+		{
+			word = SplitMix64(seed);
+		}
+	}
+
+	Xoshiro256Random::Xoshiro256Random(const State& state) : m_State(state)
+	{
+		if (state[0] == 0 && state[1] == 0 && state[2] == 0 && state[3] == 0)
+		{
+			throw std::invalid_argument("Xoshiro256Random state must not be all zeros.");
+		}
+	}
+
+	std::uint64_t Xoshiro256Random::NextUInt64()
+	{
+		const std::uint64_t result = std::rotl(m_State[0] + m_State[3], 23) + m_State[0];
+		const std::uint64_t t = m_State[1] << 17;
+
+		m_State[2] ^= m_State[0];
+		m_State[3] ^= m_State[1];
+		m_State[1] ^= m_State[2];
+		m_State[0] ^= m_State[3];
+		m_State[2] ^= t;
+		m_State[3] = std::rotl(m_State[3], 45);
+
+		return result;
+	}
+
+	std::uint32_t Xoshiro256Random::NextUInt32()
+	{
+		if (m_HasSpareHalf)
+		{
+			m_HasSpareHalf = false;
+			return m_SpareHalf;
+		}
+
+		const std::uint64_t value = NextUInt64();
+		m_SpareHalf = static_cast<std::uint32_t>(value);
+		m_HasSpareHalf = true;
+		return static_cast<std::uint32_t>(value >> 32);
+	}
+
+	std::uint32_t Xoshiro256Random::NextBelow(std::uint32_t range, std::uint32_t threshold)
+	{
+		// The high word of value * range is uniform in [0, range) unless the low word falls below
+		// 2^32 mod range; only those draws are rejected.
+		std::uint64_t product = static_cast<std::uint64_t>(NextUInt32()) * range;
+		while (static_cast<std::uint32_t>(product) < threshold)
+		{
+			product = static_cast<std::uint64_t>(NextUInt32()) * range;
+		}
+		return static_cast<std::uint32_t>(product >> 32);
+	}
+
+	int Xoshiro256Random::NextInt(int minInclusive, int maxInclusive)
+	{
+		const std::uint32_t range = GetRange(minInclusive, maxInclusive);
+		if (range == 0)
+		{
+			return static_cast<int>(NextUInt32());
+		}
+
+		std::uint64_t product = static_cast<std::uint64_t>(NextUInt32()) * range;
+		if (static_cast<std::uint32_t>(product) < range)
+		{
+			// Only now is the exact threshold needed, so most draws skip the division entirely.
+			const std::uint32_t threshold = (0u - range) % range;
+			while (static_cast<std::uint32_t>(product) < threshold)
+			{
+				product = static_cast<std::uint64_t>(NextUInt32()) * range;
+			}
+		}
+		return static_cast<int>(static_cast<std::uint32_t>(minInclusive) + static_cast<std::uint32_t>(product >> 32));
+	}
+
+	void Xoshiro256Random::Fill(std::span<int> out, int minInclusive, int maxInclusive)
+	{
+		const std::uint32_t range = GetRange(minInclusive, maxInclusive);
+		if (range == 0)
+		{
+			for (int& value : out)
+			{
+				value = static_cast<int>(NextUInt32());
+			}
+			return;
+		}
+
+		// One division per call instead of one per rejected draw.
+		const std::uint32_t threshold = (0u - range) % range;
+		const std::uint32_t offset = static_cast<std::uint32_t>(minInclusive);
+		for (int& value : out)
+		{
+			value = static_cast<int>(offset + NextBelow(range, threshold));
+		}
+	}
+}
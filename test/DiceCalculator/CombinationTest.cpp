@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <vector>
+#include "DiceCalculator/Combination.h"
+
+namespace DiceCalculator
+{
+	using Group = Combination::RollLayout::Group;
+
+	TEST(CombinationTest, RollListRoundTripsRolls)
+	{
+		Combination::RollList rolls = { Combination::Roll{ 20, 17 }, Combination::Roll{ 6, 1 }, Combination::Roll{ 1000000, 999999 } };
+
+		ASSERT_EQ(rolls.size(), 3u);
+		EXPECT_EQ(rolls[0].Sides, 20);
+		EXPECT_EQ(rolls[0].Value, 17);
+		EXPECT_EQ(rolls[1].Sides, 6);
+		EXPECT_EQ(rolls[1].Value, 1);
+		EXPECT_EQ(rolls[2].Sides, 1000000);
+		EXPECT_EQ(rolls[2].Value, 999999);
+
+		int sum = 0;
+		for (const auto& r : rolls)
+		{
+			sum += r.Value;
+		}
+		EXPECT_EQ(sum, 17 + 1 + 999999);
+		EXPECT_EQ(rolls.FindSides(6), 1u);
+		EXPECT_EQ(rolls.FindSides(8), rolls.size());
+
+		EXPECT_TRUE(Combination::RollList().empty());
+		EXPECT_EQ(sizeof(Combination::RollList), 16u);
+	}
+
+	TEST(CombinationTest, SequenceGroupsAreIndexedInOdometerOrder)
+	{
+		// 2d3 then 1d2: the last die is the least significant digit.
+		const auto& layout = Combination::RollLayout::Get({ Group{ 2, 3, false }, Group{ 1, 2, false } });
+		ASSERT_EQ(layout.GetCount(), 18u);
+		ASSERT_EQ(layout.GetRollCount(), 3u);
+
+		std::uint64_t index = 0;
+		for (int first = 1; first <= 3; ++first)
+		{
+			for (int second = 1; second <= 3; ++second)
+			{
+				for (int third = 1; third <= 2; ++third)
+				{
+					const std::vector<Combination::Roll> rolls = { { 3, first }, { 3, second }, { 2, third } };
+					EXPECT_EQ(layout.Encode(rolls), index);
+
+					const Combination::RollList list(layout, index);
+					EXPECT_EQ(list[0].Value, first) << "at index " << index;
+					EXPECT_EQ(list[1].Value, second) << "at index " << index;
+					EXPECT_EQ(list[2].Value, third) << "at index " << index;
+					EXPECT_EQ(list[2].Sides, 2);
+					++index;
+				}
+			}
+		}
+	}
+
+	TEST(CombinationTest, SortedGroupsAreIndexedInLexicographicOrder)
+	{
+		// The 20 multisets of 3 faces out of 4, enumerated as non-decreasing sequences.
+		const auto& layout = Combination::RollLayout::Get({ Group{ 3, 4, true } });
+		ASSERT_EQ(layout.GetCount(), 20u);
+
+		std::uint64_t index = 0;
+		for (int a = 1; a <= 4; ++a)
+		{
+			for (int b = a; b <= 4; ++b)
+			{
+				for (int c = b; c <= 4; ++c)
+				{
+					const Combination::RollList list(layout, index);
+					EXPECT_EQ(list[0].Value, a) << "at index " << index;
+					EXPECT_EQ(list[1].Value, b) << "at index " << index;
+					EXPECT_EQ(list[2].Value, c) << "at index " << index;
+
+					const std::vector<Combination::Roll> rolls = { { 4, a }, { 4, b }, { 4, c } };
+					EXPECT_EQ(layout.Encode(rolls), index);
+					++index;
+				}
+			}
+		}
+	}
+
+	TEST(CombinationTest, LayoutsAreSharedAndConcatenated)
+	{
+		const auto& d6 = Combination::RollLayout::Get({ Group{ 2, 6, false } });
+		EXPECT_EQ(&Combination::RollLayout::Get({ Group{ 2, 6, false }, Group{ 0, 8, false } }), &d6);
+
+		const auto& d20 = Combination::RollLayout::Get({ Group{ 1, 20, false } });
+		const Combination::RollLayout* parts[] = { &d20, nullptr, &d6 };
+		const auto& joined = Combination::RollLayout::Concatenate(parts);
+		EXPECT_EQ(&joined, &Combination::RollLayout::Get({ Group{ 1, 20, false }, Group{ 2, 6, false } }));
+		EXPECT_EQ(joined.GetCount(), 20u * 36u);
+		EXPECT_EQ(joined.GetRollCount(), 3u);
+
+		// 40d6 has 6^40 face sequences, more than an index can hold; its 1.2 million multisets fit.
+		EXPECT_THROW(Combination::RollLayout::Get({ Group{ 40, 6, false } }), std::runtime_error);
+		EXPECT_EQ(Combination::RollLayout::Get({ Group{ 40, 6, true } }).GetCount(), 1221759u);
+	}
+
+	TEST(CombinationTest, RollListRejectsRollsOutsideTheirDie)
+	{
+		EXPECT_THROW((Combination::RollList{ Combination::Roll{ 6, 7 } }), std::out_of_range);
+		EXPECT_THROW((Combination::RollList{ Combination::Roll{ 6, 0 } }), std::out_of_range);
+		EXPECT_THROW((Combination::RollList{ Combination::Roll{ 0, 1 } }), std::out_of_range);
+
+		const auto& sorted = Combination::RollLayout::Get({ Group{ 2, 6, true } });
+		const std::vector<Combination::Roll> descending = { { 6, 4 }, { 6, 2 } };
+		EXPECT_THROW(sorted.Encode(descending), std::out_of_range);
+	}
+}
@@ -105,4 +105,120 @@ namespace DiceCalculator::Expressions
 		// Sum to 1
 		EXPECT_NEAR(data[0].second + data[1].second + data[2].second, 1.0, 1e-12);
 	}
-}
\ No newline at end of file
+
+	TEST(DistributionTest, FromCombinationsCountsWeights)
+	{
+		// 2d2 as multisets: {1,1} once, {1,2} twice, {2,2} once.
+		std::vector<Combination> combos;
+		combos.push_back(Combination{ 2, { Combination::Roll{ 2, 1 }, Combination::Roll{ 2, 1 } }, 1.0 });
+		combos.push_back(Combination{ 3, { Combination::Roll{ 2, 1 }, Combination::Roll{ 2, 2 } }, 2.0 });
+		combos.push_back(Combination{ 4, { Combination::Roll{ 2, 2 }, Combination::Roll{ 2, 2 } }, 1.0 });
+
+		Distribution d = Distribution::FromCombinations(combos);
+
+		ASSERT_EQ(d.Size(), 3u);
+		EXPECT_NEAR(d[2], 0.25, 1e-12);
+		EXPECT_NEAR(d[3], 0.5, 1e-12);
+		EXPECT_NEAR(d[4], 0.25, 1e-12);
+	}
+
+	TEST(DistributionTest, ContiguousSupportIsStoredDensely)
+	{
+		Distribution d = { {2, 0.25}, {3, 0.5}, {4, 0.25} };
+
+		ASSERT_TRUE(d.IsDense());
+		EXPECT_EQ(d.GetOffset(), 2);
+		ASSERT_EQ(d.GetProbabilities().size(), 3u);
+		EXPECT_DOUBLE_EQ(d.GetProbabilities()[1], 0.5);
+	}
+
+	TEST(DistributionTest, SparseSupportFallsBackToFlatMap)
+	{
+		Distribution d = { {0, 0.5}, {1000000, 0.5} };
+
+		EXPECT_FALSE(d.IsDense());
+		EXPECT_EQ(d.Size(), 2u);
+		EXPECT_DOUBLE_EQ(d[0], 0.5);
+		EXPECT_DOUBLE_EQ(d[1000000], 0.5);
+		EXPECT_EQ(d.GetMinMax(), std::make_pair(0, 1000000));
+	}
+
+	TEST(DistributionTest, AddOutcomeFarAwaySwitchesToSparse)
+	{
+		Distribution d;
+		d.AddOutcome(1, 0.5);
+		d.AddOutcome(2, 0.25);
+		ASSERT_TRUE(d.IsDense());
+
+		d.AddOutcome(500000, 0.25);
+
+		EXPECT_FALSE(d.IsDense());
+		EXPECT_EQ(d.Size(), 3u);
+		EXPECT_DOUBLE_EQ(d[2], 0.25);
+		EXPECT_DOUBLE_EQ(d[500000], 0.25);
+	}
+
+	TEST(DistributionTest, DescendingAddOutcomeKeepsOrder)
+	{
+		Distribution d;
+		for (int value = 10; value >= -10; --value)
+		{
+			d.AddOutcome(value, 1.0);
+		}
+
+		EXPECT_TRUE(d.IsDense());
+		EXPECT_EQ(d.Size(), 21u);
+		EXPECT_EQ(d.GetMinMax(), std::make_pair(-10, 10));
+
+		int expected = -10;
+		for (const auto& [value, probability] : d)
+		{
+			EXPECT_EQ(value, expected++);
+			EXPECT_DOUBLE_EQ(probability, 1.0);
+		}
+	}
+
+	TEST(DistributionTest, FromDenseTrimsZeroEdgesAndSkipsInnerZeros)
+	{
+		Distribution d = Distribution::FromDense(-2, { 0.0, 0.0, 0.5, 0.0, 0.5, 0.0 });
+
+		EXPECT_EQ(d.GetOffset(), 0);
+		EXPECT_EQ(d.GetProbabilities().size(), 3u);
+		EXPECT_EQ(d.Size(), 2u);
+
+		const auto& data = d.GetData();
+		ASSERT_EQ(data.size(), 2u);
+		EXPECT_EQ(data[0].first, 0);
+		EXPECT_EQ(data[1].first, 2);
+	}
+
+	TEST(DistributionTest, NegatedMirrorsOutcomes)
+	{
+		Distribution d = { {1, 0.2}, {2, 0.3}, {4, 0.5} };
+
+		Distribution negated = d.Negated();
+
+		EXPECT_EQ(negated.Size(), 3u);
+		EXPECT_DOUBLE_EQ(negated[-1], 0.2);
+		EXPECT_DOUBLE_EQ(negated[-2], 0.3);
+		EXPECT_DOUBLE_EQ(negated[-4], 0.5);
+		EXPECT_EQ(negated.GetMinMax(), std::make_pair(-4, -1));
+	}
+
+	TEST(DistributionTest, ShiftMovesDenseAndSparseOutcomes)
+	{
+		Distribution dense = { {1, 0.2}, {2, 0.3}, {4, 0.5} };
+		dense.Shift(-3);
+		ASSERT_TRUE(dense.IsDense());
+		EXPECT_EQ(dense.GetOffset(), -2);
+		EXPECT_DOUBLE_EQ(dense[-2], 0.2);
+		EXPECT_DOUBLE_EQ(dense[1], 0.5);
+
+		Distribution sparse = { {0, 0.5}, {100000, 0.5} };
+		sparse.Shift(7);
+		ASSERT_FALSE(sparse.IsDense());
+		EXPECT_DOUBLE_EQ(sparse[7], 0.5);
+		EXPECT_DOUBLE_EQ(sparse[100007], 0.5);
+		EXPECT_EQ(sparse.GetMinMax(), std::make_pair(7, 100007));
+	}
+}
@@ -8,10 +8,15 @@
 #include "DiceCalculator/Operators/Advantage.h"
 #include "DiceCalculator/Operators/Subtraction.h"
 #include "DiceCalculator/IRandom.h"
+#include "DiceCalculator/ThreadPool.h"
 
 #include "DiceCalculator/TestUtilities.h"
 
+#include <algorithm>
+#include <cstdint>
 #include <memory>
+#include <stdexcept>
+#include <tuple>
 #include <vector>
 
 using namespace DiceCalculator;
@@ -547,4 +552,265 @@ namespace DiceCalculator::Evaluation
 		EXPECT_EQ(successes, 1u);
 		EXPECT_EQ(failures, 399u);
 	}
-}
\ No newline at end of file
+
+	TEST_F(CombinationVisitorTest, StreamYieldsSameSequenceAsGetCombinationsAndRewinds)
+	{
+		auto node = CreateGreaterThanOrEqualNode(
+			CreateAdditionNode({ CreateAdvantageNode(CreateDice(1, 4)), CreateConstant(1) }),
+			CreateSubtractionNode({ CreateDice(2, 3), CreateConstant(1) }));
+
+		DiceCalculator::Evaluation::CombinationAstVisitor visitor;
+		node->Accept(visitor);
+		const auto expected = visitor.GetCombinations();
+		ASSERT_EQ(expected.size(), 16u * 9u);
+
+		auto stream = visitor.TakeStream();
+		for (int pass = 0; pass < 2; ++pass)
+		{
+			stream->Reset();
+			Combination c;
+			size_t index = 0;
+			while (stream->Next(c))
+			{
+				ASSERT_LT(index, expected.size());
+				EXPECT_EQ(c.TotalValue, expected[index].TotalValue);
+				ASSERT_EQ(c.Rolls.size(), expected[index].Rolls.size());
+				for (size_t r = 0; r < c.Rolls.size(); ++r)
+				{
+					EXPECT_EQ(c.Rolls[r].Sides, expected[index].Rolls[r].Sides);
+					EXPECT_EQ(c.Rolls[r].Value, expected[index].Rolls[r].Value);
+				}
+				++index;
+			}
+			EXPECT_EQ(index, expected.size()) << "pass " << pass;
+			EXPECT_FALSE(stream->Next(c));
+		}
+	}
+
+	TEST_F(CombinationVisitorTest, FromCombinationsFoldsStreamBeyondMaterializationThreshold)
+	{
+		// 8d8 has 8^8 (about 16.8 million) outcomes, more than GetCombinations would materialize.
+		auto node = CreateDice(8, 8);
+
+		DiceCalculator::Evaluation::CombinationAstVisitor visitor;
+		node->Accept(visitor);
+		auto stream = visitor.TakeStream();
+		const Distribution dist = Distribution::FromCombinations(*stream);
+
+		EXPECT_EQ(dist.Size(), 57u);
+		const double total = 16777216.0;
+		EXPECT_DOUBLE_EQ(dist[8], 1.0 / total);
+		EXPECT_DOUBLE_EQ(dist[64], 1.0 / total);
+		EXPECT_DOUBLE_EQ(dist[9], 8.0 / total);
+		EXPECT_DOUBLE_EQ(dist[10], 36.0 / total);
+	}
+
+	TEST_F(CombinationVisitorTest, MultisetCountingEnumeratesSortedFacesWithMultinomialWeights)
+	{
+		auto node = CreateDice(10, 6);
+
+		DiceCalculator::Evaluation::CombinationAstVisitor visitor(CombinationAstVisitor::Counting::Multisets);
+		node->Accept(visitor);
+		const auto combinations = visitor.GetCombinations();
+
+		// C(10 + 6 - 1, 10) multisets standing for 6^10 sequences.
+		ASSERT_EQ(combinations.size(), 3003u);
+		double totalWeight = 0.0;
+		for (const auto& c : combinations)
+		{
+			ASSERT_EQ(c.Rolls.size(), 10u);
+			for (size_t r = 1; r < c.Rolls.size(); ++r)
+			{
+				EXPECT_LE(c.Rolls[r - 1].Value, c.Rolls[r].Value);
+			}
+			totalWeight += c.Weight;
+		}
+		EXPECT_DOUBLE_EQ(totalWeight, 60466176.0);
+
+		// {1, 1, ..., 1, 2} has 10 orderings.
+		EXPECT_EQ(combinations[1].TotalValue, 11);
+		EXPECT_DOUBLE_EQ(combinations[1].Weight, 10.0);
+	}
+
+	TEST_F(CombinationVisitorTest, MultisetCountingMatchesSequenceDistribution)
+	{
+		auto node = CreateGreaterThanOrEqualNode(
+			CreateAdditionNode({ CreateAdvantageNode(CreateDice(2, 4)), CreateDice(3, 3), CreateConstant(1) }),
+			CreateSubtractionNode({ CreateDice(3, 6), CreateDice(1, 2) }));
+
+		DiceCalculator::Evaluation::CombinationAstVisitor sequences;
+		node->Accept(sequences);
+		const Distribution expected = Distribution::FromCombinations(*sequences.TakeStream());
+
+		DiceCalculator::Evaluation::CombinationAstVisitor multisets(CombinationAstVisitor::Counting::Multisets);
+		node->Accept(multisets);
+		const Distribution actual = Distribution::FromCombinations(*multisets.TakeStream());
+
+		ASSERT_EQ(actual.Size(), expected.Size());
+		for (const auto& [value, probability] : expected)
+		{
+			EXPECT_NEAR(actual[value], probability, 1e-12) << "at value " << value;
+		}
+	}
+
+	TEST_F(CombinationVisitorTest, PartitionedShardsYieldEveryCombinationExactlyOnce)
+	{
+		auto node = CreateAdditionNode({
+			CreateConstant(2),
+			CreateSubtractionNode({ CreateDice(2, 3), CreateDice(1, 4) }),
+			CreateAdvantageNode(CreateDice(1, 5)) });
+
+		auto key = [](const Combination& c)
+		{
+			std::vector<int> rolls;
+			for (const auto& r : c.Rolls)
+			{
+				rolls.push_back(r.Sides * 100 + r.Value);
+			}
+			return std::make_tuple(c.TotalValue, rolls, c.Weight);
+		};
+
+		for (auto counting : { CombinationAstVisitor::Counting::Sequences, CombinationAstVisitor::Counting::Multisets })
+		{
+			DiceCalculator::Evaluation::CombinationAstVisitor visitor(counting);
+			node->Accept(visitor);
+			auto stream = visitor.TakeStream();
+
+			std::vector<std::tuple<int, std::vector<int>, double>> expected;
+			Combination c;
+			while (stream->Next(c))
+			{
+				expected.push_back(key(c));
+			}
+
+			for (std::size_t count : { 1u, 2u, 5u, 64u })
+			{
+				auto shards = stream->Partition(count);
+				EXPECT_GE(shards.size(), 1u);
+
+				std::vector<std::tuple<int, std::vector<int>, double>> actual;
+				for (auto& shard : shards)
+				{
+					while (shard->Next(c))
+					{
+						actual.push_back(key(c));
+					}
+				}
+
+				auto sortedExpected = expected;
+				std::sort(sortedExpected.begin(), sortedExpected.end());
+				std::sort(actual.begin(), actual.end());
+				EXPECT_EQ(actual, sortedExpected) << "count " << count;
+			}
+		}
+	}
+
+	TEST_F(CombinationVisitorTest, ParallelDistributionMatchesSequentialFold)
+	{
+		auto node = CreateGreaterThanOrEqualNode(
+			CreateAdditionNode({ CreateDisadvantageNode(CreateDice(2, 6)), CreateDice(3, 4) }),
+			CreateSubtractionNode({ CreateDice(2, 8), CreateConstant(1) }));
+		auto pool = std::make_shared<ThreadPool>(4);
+
+		for (auto counting : { CombinationAstVisitor::Counting::Sequences, CombinationAstVisitor::Counting::Multisets })
+		{
+			DiceCalculator::Evaluation::CombinationAstVisitor sequential(counting);
+			node->Accept(sequential);
+			const Distribution expected = sequential.GetDistribution();
+
+			DiceCalculator::Evaluation::CombinationAstVisitor parallel(counting, pool);
+			node->Accept(parallel);
+			const Distribution actual = parallel.GetDistribution();
+
+			ASSERT_EQ(actual.Size(), expected.Size());
+			for (const auto& [value, probability] : expected)
+			{
+				EXPECT_NEAR(actual[value], probability, 1e-12) << "at value " << value;
+			}
+		}
+	}
+
+	TEST_F(CombinationVisitorTest, DiceStreamsSplitIntoEqualIndexRanges)
+	{
+		// 2d3 has 9 sequences and 6 multisets, so both split into more shards than a die has faces.
+		DiceCombinationStream sequences(2, 3);
+		MultisetDiceCombinationStream multisets(2, 3);
+
+		for (auto* stream : { static_cast<CombinationStream*>(&sequences), static_cast<CombinationStream*>(&multisets) })
+		{
+			std::vector<int> expected;
+			Combination c;
+			while (stream->Next(c))
+			{
+				expected.push_back(c.Rolls[0].Value * 10 + c.Rolls[1].Value);
+			}
+
+			auto shards = stream->Partition(4);
+			ASSERT_EQ(shards.size(), 4u);
+
+			// Shards hold consecutive ranges of at least expected.size() / 4 combinations, in order.
+			std::vector<int> actual;
+			for (auto& shard : shards)
+			{
+				std::size_t shardSize = 0;
+				while (shard->Next(c))
+				{
+					actual.push_back(c.Rolls[0].Value * 10 + c.Rolls[1].Value);
+					++shardSize;
+				}
+				EXPECT_GE(shardSize, expected.size() / 4);
+				EXPECT_LE(shardSize, expected.size() / 4 + 1);
+			}
+			EXPECT_EQ(actual, expected);
+		}
+	}
+
+	TEST_F(CombinationVisitorTest, StreamCountsMatchEnumeration)
+	{
+		auto node = CreateGreaterThanOrEqualNode(
+			CreateAdditionNode({ CreateAdvantageNode(CreateDice(2, 6)), CreateDice(3, 4), CreateConstant(2) }),
+			CreateSubtractionNode({ CreateDice(2, 8), CreateDice(0, 6) }));
+
+		for (auto counting : { CombinationAstVisitor::Counting::Sequences, CombinationAstVisitor::Counting::Multisets })
+		{
+			CombinationAstVisitor visitor(counting);
+			node->Accept(visitor);
+			auto stream = visitor.TakeStream();
+
+			std::uint64_t enumerated = 0;
+			Combination c;
+			while (stream->Next(c))
+			{
+				++enumerated;
+			}
+			EXPECT_EQ(stream->Count(), enumerated);
+
+			std::uint64_t sharded = 0;
+			for (const auto& shard : stream->Partition(5))
+			{
+				sharded += shard->Count();
+			}
+			EXPECT_EQ(sharded, enumerated);
+		}
+	}
+
+	TEST_F(CombinationVisitorTest, DistributionRefusesStreamsAboveTheLimit)
+	{
+		// 20 * C(21, 10) * C(29, 10), about 1.4e14 multiset combinations: the fold must fail up front
+		// instead of enumerating them.
+		auto huge = CreateAttackRollNode(CreateAdditionNode({ CreateDice(1, 20), CreateDice(10, 12) }), CreateDice(10, 20));
+		CombinationAstVisitor visitor(CombinationAstVisitor::Counting::Multisets, std::make_shared<ThreadPool>(2));
+		huge->Accept(visitor);
+		EXPECT_THROW(visitor.GetDistribution(), std::runtime_error);
+		EXPECT_THROW(visitor.GetCombinations(), std::runtime_error);
+
+		// 2d6 has 36 sequences: a limit of 36 folds them, a limit of 35 does not.
+		CombinationAstVisitor exact(CombinationAstVisitor::Counting::Sequences, nullptr, 36);
+		CreateDice(2, 6)->Accept(exact);
+		EXPECT_NO_THROW(exact.GetDistribution());
+
+		CombinationAstVisitor tooSmall(CombinationAstVisitor::Counting::Sequences, nullptr, 35);
+		CreateDice(2, 6)->Accept(tooSmall);
+		EXPECT_THROW(tooSmall.GetDistribution(), std::runtime_error);
+	}
+}
@@ -4,6 +4,9 @@
 #include "DiceCalculator/TestUtilities.h"
 #include "DiceCalculator/Operators/Subtraction.h"
 
+#include <cmath>
+#include <limits>
+
 namespace DiceCalculator::Evaluation
 {
 	using namespace DiceCalculator::TestUtilities;
@@ -375,6 +378,187 @@ namespace DiceCalculator::Evaluation
 		EXPECT_DOUBLE_EQ(dist[0], 6.0 / 9);
 	}
 
+	TEST_F(DistributionVisitorTest, LargeDicePoolsSumToOneWithExpectedMean)
+	{
+		// 40d12 + 30d10
+		auto additionNode = CreateAdditionNode({ CreateDice(40, 12), CreateDice(30, 10) });
+
+		DiceCalculator::Evaluation::ConvolutionAstVisitor visitor;
+
+		additionNode->Accept(visitor);
+		const auto& dist = visitor.GetDistribution();
+
+		EXPECT_TRUE(dist.IsDense());
+		EXPECT_EQ(dist.GetMinMax(), std::make_pair(70, 780));
+
+		double total = 0.0;
+		double mean = 0.0;
+		for (const auto& [value, probability] : dist)
+		{
+			total += probability;
+			mean += value * probability;
+		}
+		EXPECT_NEAR(total, 1.0, 1e-9);
+		EXPECT_NEAR(mean, 40 * 6.5 + 30 * 5.5, 1e-6);
+	}
+
+	TEST_F(DistributionVisitorTest, ThousandDiceSixSidesHasExpectedMoments)
+	{
+		auto node = CreateDice(1000, 6);
+		DiceCalculator::Evaluation::ConvolutionAstVisitor visitor;
+
+		node->Accept(visitor);
+		const auto& dist = visitor.GetDistribution();
+
+		double total = 0.0;
+		double mean = 0.0;
+		double secondMoment = 0.0;
+		for (const auto& [value, probability] : dist)
+		{
+			total += probability;
+			mean += value * probability;
+			secondMoment += static_cast<double>(value) * value * probability;
+		}
+		EXPECT_NEAR(total, 1.0, 1e-12);
+		EXPECT_NEAR(mean, 3500.0, 1e-8);
+		// Variance of one d6 is 35/12.
+		EXPECT_NEAR(secondMoment - mean * mean, 1000 * 35.0 / 12.0, 1e-5);
+		EXPECT_LE(dist.GetMinMax().second, 6000);
+	}
+
+	// FFT and direct kernels must agree to within round-off: on the same support, to the given absolute
+	// tolerance, and to a relative tolerance in every slot so that the far tails are checked as well.
+	static void ExpectFftMatchesDirect(const std::shared_ptr<DiceCalculator::Expressions::DiceAst>& ast, double tolerance)
+	{
+		DiceCalculator::Evaluation::ConvolutionAstVisitor directVisitor(Convolver(Convolver::Settings{ .FftThreshold = std::numeric_limits<std::size_t>::max() }));
+		DiceCalculator::Evaluation::ConvolutionAstVisitor fftVisitor(Convolver(Convolver::Settings{ .FftThreshold = 1 }));
+
+		ast->Accept(directVisitor);
+		ast->Accept(fftVisitor);
+		const auto& direct = directVisitor.GetDistribution();
+		const auto& fft = fftVisitor.GetDistribution();
+
+		ASSERT_EQ(fft.GetMinMax(), direct.GetMinMax());
+		double fftTotal = 0.0;
+		for (const auto& [value, probability] : fft)
+		{
+			EXPECT_GT(probability, 0.0) << "at value " << value;
+			fftTotal += probability;
+		}
+		EXPECT_NEAR(fftTotal, 1.0, 1e-12);
+
+		for (const auto& [value, probability] : direct)
+		{
+			EXPECT_NEAR(fft[value], probability, tolerance) << "at value " << value;
+			EXPECT_NEAR(fft[value], probability, 1e-8 * probability) << "at value " << value;
+		}
+	}
+
+	TEST_F(DistributionVisitorTest, FftMatchesDirectForLargeDicePool)
+	{
+		ExpectFftMatchesDirect(CreateDice(200, 100), 1e-14);
+	}
+
+	TEST_F(DistributionVisitorTest, FftMatchesDirectForSumOfLargePools)
+	{
+		ExpectFftMatchesDirect(CreateAdditionNode({ CreateDice(40, 12), CreateDice(30, 10), CreateConstant(-5) }), 1e-14);
+	}
+
+	TEST_F(DistributionVisitorTest, FftMatchesDirectForDifferenceOfPools)
+	{
+		ExpectFftMatchesDirect(CreateSubtractionNode({ CreateDice(20, 20), CreateDice(30, 6) }), 1e-14);
+	}
+
+	TEST_F(DistributionVisitorTest, FftKeepsTailsOfLargePools)
+	{
+		// The extreme sums of 100d12 + 80d10 are about 1e-188, far below the FFT round-off.
+		auto ast = CreateAdditionNode({ CreateDice(100, 12), CreateDice(80, 10) });
+		ExpectFftMatchesDirect(ast, 1e-14);
+
+		DiceCalculator::Evaluation::ConvolutionAstVisitor fftVisitor(Convolver(Convolver::Settings{ .FftThreshold = 1 }));
+		ast->Accept(fftVisitor);
+		const auto& dist = fftVisitor.GetDistribution();
+
+		const double extreme = std::pow(12.0, -100) * std::pow(10.0, -80);
+		EXPECT_EQ(dist.GetMinMax(), std::make_pair(180, 2000));
+		EXPECT_NEAR(dist[180], extreme, 1e-12 * extreme);
+		EXPECT_NEAR(dist[2000], extreme, 1e-12 * extreme);
+	}
+
+	TEST_F(DistributionVisitorTest, FftMatchesDirectForSmallDistributions)
+	{
+		// Exact values are well above the round-off bound, so the FFT results are kept.
+		DiceCalculator::Evaluation::ConvolutionAstVisitor fftVisitor(Convolver(Convolver::Settings{ .FftThreshold = 1 }));
+
+		CreateDice(3, 3)->Accept(fftVisitor);
+		const auto& dist = fftVisitor.GetDistribution();
+
+		EXPECT_EQ(dist.Size(), 7u);
+		EXPECT_NEAR(dist[3], 1.0 / 27, 1e-15);
+		EXPECT_NEAR(dist[4], 3.0 / 27, 1e-15);
+		EXPECT_NEAR(dist[5], 6.0 / 27, 1e-15);
+		EXPECT_NEAR(dist[6], 7.0 / 27, 1e-15);
+		EXPECT_NEAR(dist[7], 6.0 / 27, 1e-15);
+		EXPECT_NEAR(dist[8], 3.0 / 27, 1e-15);
+		EXPECT_NEAR(dist[9], 1.0 / 27, 1e-15);
+	}
+
+	TEST_F(DistributionVisitorTest, ParallelEvaluationIsBitIdenticalToSequential)
+	{
+		// A 12-term damage expression with nested sums, differences, a comparison and terms large
+		// enough to take the FFT path.
+		auto ast = CreateAdditionNode({
+			CreateDice(2, 6), CreateDice(1, 8), CreateConstant(4),
+			CreateSubtractionNode({ CreateDice(60, 20), CreateDice(3, 4), CreateConstant(2) }),
+			CreateDice(100, 12), CreateAdvantageNode(CreateDice(1, 20)),
+			CreateAdditionNode({ CreateDice(4, 10), CreateDice(2, 100) }),
+			CreateGreaterThanNode(CreateDice(3, 6), CreateDice(2, 8)),
+			CreateDice(1, 4), CreateConstant(-3), CreateDice(8, 6), CreateDice(50, 10)
+			});
+		Convolver convolver(Convolver::Settings{ .FftThreshold = 64 });
+
+		DiceCalculator::Evaluation::ConvolutionAstVisitor sequentialVisitor(convolver);
+		ast->Accept(sequentialVisitor);
+		const Distribution& sequential = sequentialVisitor.GetDistribution();
+
+		DiceCalculator::Evaluation::ConvolutionAstVisitor parallelVisitor(convolver, std::make_shared<ThreadPool>(4));
+		for (int run = 0; run < 3; ++run)
+		{
+			ast->Accept(parallelVisitor);
+			const Distribution& parallel = parallelVisitor.GetDistribution();
+
+			ASSERT_EQ(parallel.Size(), sequential.Size());
+			for (const auto& [value, probability] : sequential)
+			{
+				ASSERT_EQ(parallel[value], probability) << "at value " << value;
+			}
+		}
+	}
+
+	TEST_F(DistributionVisitorTest, ManyTermSumMatchesExpectedMean)
+	{
+		std::vector<std::shared_ptr<DiceCalculator::Expressions::DiceAst>> terms;
+		double expectedMean = 0.0;
+		for (int i = 1; i <= 9; ++i)
+		{
+			terms.push_back(CreateDice(i, 2 * i + 2));
+			expectedMean += i * (2 * i + 3) / 2.0;
+		}
+		DiceCalculator::Evaluation::ConvolutionAstVisitor visitor;
+
+		CreateAdditionNode(terms)->Accept(visitor);
+
+		double total = 0.0;
+		double mean = 0.0;
+		for (const auto& [value, probability] : visitor.GetDistribution())
+		{
+			total += probability;
+			mean += value * probability;
+		}
+		EXPECT_NEAR(total, 1.0, 1e-12);
+		EXPECT_NEAR(mean, expectedMean, 1e-9);
+	}
+
 	/*
 
 	TEST_F(DistributionVisitorTest, AttackRollNormal)
@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+#include <random>
+#include "DiceCalculator/Evaluation/ConvolutionKernels.h"
+
+namespace DiceCalculator::Evaluation
+{
+	namespace
+	{
+		std::vector<double> RandomProbabilities(std::size_t size, std::mt19937& rng)
+		{
+			std::uniform_real_distribution<double> uniform(0.0, 1.0);
+			std::vector<double> values(size);
+			for (auto& value : values)
+			{
+				value = uniform(rng);
+			}
+			// Inner zeros exercise the skipped rows.
+			if (size > 2)
+			{
+				values[size / 2] = 0.0;
+			}
+			return values;
+		}
+	}
+
+	TEST(ConvolutionKernelsTest, ScalarIsAlwaysSupported)
+	{
+		EXPECT_TRUE(ConvolutionKernels::IsSupported(ConvolutionKernels::InstructionSet::Scalar));
+		EXPECT_NE(ConvolutionKernels::GetDirectKernel(ConvolutionKernels::InstructionSet::Scalar), nullptr);
+		EXPECT_NE(ConvolutionKernels::GetDirectKernel(ConvolutionKernels::GetBestSupported()), nullptr);
+	}
+
+	TEST(ConvolutionKernelsTest, AllSupportedKernelsMatchScalar)
+	{
+		using InstructionSet = ConvolutionKernels::InstructionSet;
+		std::mt19937 rng(1234);
+		const auto scalar = ConvolutionKernels::GetDirectKernel(InstructionSet::Scalar);
+
+		for (InstructionSet instructionSet : { InstructionSet::Sse2, InstructionSet::Avx2, InstructionSet::Avx512 })
+		{
+			const auto kernel = ConvolutionKernels::GetDirectKernel(instructionSet);
+			if (kernel == nullptr)
+			{
+				EXPECT_FALSE(ConvolutionKernels::IsSupported(instructionSet));
+				continue;
+			}
+
+			// Sizes straddle every vector width and unroll factor to cover the scalar tails.
+			for (std::size_t lhsSize : { 1u, 3u, 17u, 64u })
+			{
+				for (std::size_t rhsSize : { 1u, 2u, 7u, 15u, 16u, 33u, 301u })
+				{
+					auto lhs = RandomProbabilities(lhsSize, rng);
+					auto rhs = RandomProbabilities(rhsSize, rng);
+					std::vector<double> expected(lhsSize + rhsSize - 1, 0.0);
+					std::vector<double> actual(lhsSize + rhsSize - 1, 0.0);
+
+					scalar(lhs.data(), lhsSize, rhs.data(), rhsSize, expected.data());
+					kernel(lhs.data(), lhsSize, rhs.data(), rhsSize, actual.data());
+
+					for (std::size_t i = 0; i < expected.size(); ++i)
+					{
+						EXPECT_NEAR(actual[i], expected[i], 1e-12 * (1.0 + expected[i]))
+							<< ConvolutionKernels::GetName(instructionSet) << " " << lhsSize << "x" << rhsSize << " at " << i;
+					}
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,222 @@
+#include <gtest/gtest.h>
+
+#include "DiceCalculator/Evaluation/Convolver.h"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace DiceCalculator::Evaluation
+{
+	TEST(ConvolverTest, AddDenseDistributions)
+	{
+		Distribution d6 = Distribution::FromDense(1, std::vector<double>(6, 1.0 / 6));
+
+		Distribution sum = Convolver().Add(d6, d6);
+
+		ASSERT_TRUE(sum.IsDense());
+		EXPECT_EQ(sum.Size(), 11u);
+		EXPECT_DOUBLE_EQ(sum[2], 1.0 / 36);
+		EXPECT_DOUBLE_EQ(sum[7], 6.0 / 36);
+		EXPECT_DOUBLE_EQ(sum[12], 1.0 / 36);
+	}
+
+	TEST(ConvolverTest, AddSparseAndDenseDistributions)
+	{
+		Distribution sparse = { {0, 0.5}, {1000000, 0.5} };
+		Distribution coin = { {0, 0.5}, {1, 0.5} };
+
+		Distribution sum = Convolver().Add(sparse, coin);
+
+		EXPECT_FALSE(sum.IsDense());
+		EXPECT_EQ(sum.Size(), 4u);
+		EXPECT_DOUBLE_EQ(sum[0], 0.25);
+		EXPECT_DOUBLE_EQ(sum[1], 0.25);
+		EXPECT_DOUBLE_EQ(sum[1000000], 0.25);
+		EXPECT_DOUBLE_EQ(sum[1000001], 0.25);
+	}
+
+	TEST(ConvolverTest, SubtractProducesDifferenceDistribution)
+	{
+		Distribution d3 = Distribution::FromDense(1, std::vector<double>(3, 1.0 / 3));
+		Distribution constant = { {10, 1.0} };
+
+		Distribution difference = Convolver().Subtract(constant, d3);
+
+		EXPECT_EQ(difference.Size(), 3u);
+		EXPECT_DOUBLE_EQ(difference[7], 1.0 / 3);
+		EXPECT_DOUBLE_EQ(difference[8], 1.0 / 3);
+		EXPECT_DOUBLE_EQ(difference[9], 1.0 / 3);
+	}
+
+	TEST(ConvolverTest, AddWithEmptyDistributionIsEmpty)
+	{
+		Distribution d6 = Distribution::FromDense(1, std::vector<double>(6, 1.0 / 6));
+
+		EXPECT_TRUE(Convolver().Add(d6, Distribution()).IsEmpty());
+	}
+
+	TEST(ConvolverTest, PowerMatchesRepeatedAddition)
+	{
+		Convolver convolver;
+		Distribution d = { {0, 0.2}, {1, 0.5}, {3, 0.3} };
+
+		for (int exponent = 1; exponent <= 13; ++exponent)
+		{
+			Distribution expected = d;
+			for (int i = 1; i < exponent; ++i)
+			{
+				expected = convolver.Add(expected, d);
+			}
+
+			Distribution power = convolver.Power(d, exponent);
+
+			ASSERT_EQ(power.Size(), expected.Size()) << "exponent " << exponent;
+			for (const auto& [value, probability] : expected)
+			{
+				EXPECT_NEAR(power[value], probability, 1e-15) << "exponent " << exponent << " at value " << value;
+			}
+		}
+	}
+
+	TEST(ConvolverTest, PowerZeroIsPointMassAtZero)
+	{
+		Distribution d = { {1, 0.5}, {2, 0.5} };
+
+		Distribution power = Convolver().Power(d, 0);
+
+		EXPECT_EQ(power.Size(), 1u);
+		EXPECT_DOUBLE_EQ(power[0], 1.0);
+	}
+
+	TEST(ConvolverTest, PowerRejectsNegativeExponent)
+	{
+		Distribution d = { {1, 1.0} };
+
+		EXPECT_THROW(Convolver().Power(d, -1), std::invalid_argument);
+	}
+
+	TEST(ConvolverTest, UniformDiceSumMatchesExactCounts)
+	{
+		Distribution d = Convolver().UniformDiceSum(3, 6);
+
+		EXPECT_EQ(d.GetMinMax(), std::make_pair(3, 18));
+		EXPECT_DOUBLE_EQ(d[3], 1.0 / 216.0);
+		EXPECT_DOUBLE_EQ(d[4], 3.0 / 216.0);
+		EXPECT_DOUBLE_EQ(d[10], 27.0 / 216.0);
+		EXPECT_DOUBLE_EQ(d[11], 27.0 / 216.0);
+		EXPECT_DOUBLE_EQ(d[18], 1.0 / 216.0);
+	}
+
+	TEST(ConvolverTest, UniformDiceSumExactAndPowerAgree)
+	{
+		Convolver::Settings powerOnly;
+		powerOnly.ExactDiceWorkLimit = 0;
+
+		for (auto [rolls, sides] : { std::pair{ 1, 1 }, std::pair{ 5, 1 }, std::pair{ 1, 20 }, std::pair{ 7, 2 }, std::pair{ 50, 20 }, std::pair{ 300, 6 } })
+		{
+			Distribution exact = Convolver().UniformDiceSum(rolls, sides);
+			Distribution power = Convolver(powerOnly).UniformDiceSum(rolls, sides);
+
+			EXPECT_EQ(exact.GetMinMax(), std::make_pair(rolls, rolls * sides)) << rolls << "d" << sides;
+			EXPECT_EQ(power.GetMinMax(), exact.GetMinMax()) << rolls << "d" << sides;
+			double total = 0.0;
+			for (const auto& [value, probability] : exact)
+			{
+				total += probability;
+				EXPECT_NEAR(probability, power[value], 1e-14) << rolls << "d" << sides << " at value " << value;
+			}
+			EXPECT_NEAR(total, 1.0, 1e-14);
+		}
+	}
+
+	TEST(ConvolverTest, FftKeepsTailsOfDistributionsThatAreNotLogConcave)
+	{
+		// Two humps far apart, with tails well below the FFT round-off.
+		std::vector<double> values(1500);
+		double total = 0.0;
+		for (std::size_t i = 0; i < values.size(); ++i)
+		{
+			const double low = (static_cast<double>(i) - 300.0) / 40.0;
+			const double high = (static_cast<double>(i) - 1200.0) / 40.0;
+			values[i] = std::exp(-low * low) + 0.5 * std::exp(-high * high);
+			total += values[i];
+		}
+		for (double& value : values)
+		{
+			value /= total;
+		}
+		const Distribution d = Distribution::FromDense(0, values);
+
+		const Distribution direct = Convolver(Convolver::Settings{ .FftThreshold = std::numeric_limits<std::size_t>::max() }).Add(d, d);
+		const Distribution fft = Convolver(Convolver::Settings{ .FftThreshold = 1 }).Add(d, d);
+
+		ASSERT_EQ(fft.GetMinMax(), direct.GetMinMax());
+		for (const auto& [value, probability] : direct)
+		{
+			EXPECT_NEAR(fft[value], probability, 1e-8 * probability) << "at value " << value;
+		}
+	}
+
+	TEST(ConvolverTest, UniformDiceSumIsSymmetric)
+	{
+		Distribution d = Convolver().UniformDiceSum(41, 12);
+
+		for (int value = 41; value <= 41 * 12; ++value)
+		{
+			EXPECT_EQ(d[value], d[41 * 13 - value]) << "at value " << value;
+		}
+	}
+
+	TEST(ConvolverTest, AddUniformMatchesConvolutionWithDie)
+	{
+		Distribution d = { {-2, 0.1}, {0, 0.25}, {1, 0.4}, {5, 0.25} };
+		Distribution die = Distribution::FromDense(1, std::vector<double>(7, 1.0 / 7.0));
+
+		Distribution expected = Convolver().Add(d, die);
+		Distribution result = Convolver::AddUniform(d, 1, 7);
+
+		ASSERT_EQ(result.GetMinMax(), expected.GetMinMax());
+		for (const auto& [value, probability] : expected)
+		{
+			EXPECT_NEAR(result[value], probability, 1e-16) << "at value " << value;
+		}
+	}
+
+	TEST(ConvolverTest, AddUniformKeepsRelativeAccuracyInTails)
+	{
+		Distribution d = Distribution::FromDense(0, { 1e-300, 1.0 - 2e-300, 1e-300 });
+
+		Distribution result = Convolver::AddUniform(d, 0, 2);
+
+		EXPECT_DOUBLE_EQ(result[0], 0.5e-300);
+		EXPECT_DOUBLE_EQ(result[3], 0.5e-300);
+	}
+
+	TEST(ConvolverTest, AddDiceAndSubtractDiceMatchConvolution)
+	{
+		Convolver convolver;
+		Distribution d = convolver.UniformDiceSum(4, 10);
+
+		for (auto [rolls, sides] : { std::pair{ 1, 20 }, std::pair{ 3, 6 }, std::pair{ 12, 4 } })
+		{
+			Distribution pool = convolver.UniformDiceSum(rolls, sides);
+			Distribution expectedSum = convolver.Add(d, pool);
+			Distribution expectedDifference = convolver.Subtract(d, pool);
+
+			Distribution sum = convolver.AddDice(d, rolls, sides);
+			Distribution difference = convolver.SubtractDice(d, rolls, sides);
+
+			ASSERT_EQ(sum.GetMinMax(), expectedSum.GetMinMax());
+			ASSERT_EQ(difference.GetMinMax(), expectedDifference.GetMinMax());
+			for (const auto& [value, probability] : expectedSum)
+			{
+				EXPECT_NEAR(sum[value], probability, 1e-15) << rolls << "d" << sides << " at value " << value;
+			}
+			for (const auto& [value, probability] : expectedDifference)
+			{
+				EXPECT_NEAR(difference[value], probability, 1e-15) << rolls << "d" << sides << " at value " << value;
+			}
+		}
+	}
+}
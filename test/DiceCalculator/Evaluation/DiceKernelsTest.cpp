@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "DiceCalculator/Evaluation/DiceKernels.h"
+
+namespace DiceCalculator::Evaluation
+{
+	namespace
+	{
+		DiceKernels::State CreateState()
+		{
+			DiceKernels::State state;
+			std::uint32_t value = 0x9E3779B9u;
+			for (auto& word : state.Words)
+			{
+				for (auto& lane : word)
+				{
+					value = value * 1664525u + 1013904223u;
+					lane = value;
+				}
+			}
+			return state;
+		}
+	}
+
+	TEST(DiceKernelsTest, ScalarIsAlwaysSupported)
+	{
+		EXPECT_TRUE(DiceKernels::IsSupported(DiceKernels::InstructionSet::Scalar));
+		EXPECT_NE(DiceKernels::GetRollKernel(DiceKernels::InstructionSet::Scalar), nullptr);
+		EXPECT_NE(DiceKernels::GetRollKernel(DiceKernels::GetBestSupported()), nullptr);
+		EXPECT_EQ(DiceKernels::GetRollKernel(DiceKernels::InstructionSet::Sse2), nullptr);
+	}
+
+	TEST(DiceKernelsTest, AllSupportedKernelsMatchScalar)
+	{
+		using InstructionSet = DiceKernels::InstructionSet;
+		const auto scalar = DiceKernels::GetRollKernel(InstructionSet::Scalar);
+
+		for (InstructionSet instructionSet : { InstructionSet::Avx2 })
+		{
+			const auto kernel = DiceKernels::GetRollKernel(instructionSet);
+			if (kernel == nullptr)
+			{
+				EXPECT_FALSE(DiceKernels::IsSupported(instructionSet));
+				continue;
+			}
+
+			// Counts straddle the lane width; 3 sides rejects often enough to exercise the redraws.
+			for (std::size_t count : { 1u, 7u, 8u, 9u, 100u })
+			{
+				for (std::uint32_t sides : { 1u, 3u, 6u, 20u, 65536u, 0x7FFFFFFFu })
+				{
+					DiceKernels::State expectedState = CreateState();
+					DiceKernels::State actualState = CreateState();
+					std::vector<int> expectedSums(count);
+					std::vector<int> actualSums(count);
+					std::vector<int> expectedFirst(count);
+					std::vector<int> actualFirst(count);
+
+					scalar(expectedState, 3, sides, expectedSums.data(), expectedFirst.data(), count);
+					kernel(actualState, 3, sides, actualSums.data(), actualFirst.data(), count);
+
+					EXPECT_EQ(actualSums, expectedSums) << DiceKernels::GetName(instructionSet) << " " << count << "x3d" << sides;
+					EXPECT_EQ(actualFirst, expectedFirst) << DiceKernels::GetName(instructionSet) << " " << count << "x3d" << sides;
+					for (std::size_t word = 0; word < 4; ++word)
+					{
+						for (std::size_t lane = 0; lane < DiceKernels::Lanes; ++lane)
+						{
+							EXPECT_EQ(actualState.Words[word][lane], expectedState.Words[word][lane]);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	TEST(DiceKernelsTest, RollDiceSumsUniformFaces)
+	{
+		DiceKernels::State state = CreateState();
+		std::vector<int> sums(60000);
+		std::vector<int> firstFaces(sums.size());
+		DiceKernels::RollDice(state, 2, 6, sums.data(), firstFaces.data(), sums.size());
+
+		std::array<int, 6> counts = {};
+		for (std::size_t i = 0; i < sums.size(); ++i)
+		{
+			ASSERT_GE(firstFaces[i], 1);
+			ASSERT_LE(firstFaces[i], 6);
+			ASSERT_GE(sums[i] - firstFaces[i], 1);
+			ASSERT_LE(sums[i] - firstFaces[i], 6);
+			++counts[static_cast<std::size_t>(firstFaces[i] - 1)];
+		}
+		for (const int count : counts)
+		{
+			EXPECT_NEAR(count, 10000, 500);
+		}
+	}
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+
+#include "DiceCalculator/Evaluation/DistributionCache.h"
+#include "DiceCalculator/Evaluation/ConvolutionAstVisitor.h"
+#include "DiceCalculator/TestUtilities.h"
+
+namespace DiceCalculator::Evaluation
+{
+	class DistributionCacheTest : public DiceCalculator::TestUtilities::TestHelpers
+	{
+	};
+
+	TEST_F(DistributionCacheTest, FindsEntriesByStructure)
+	{
+		DistributionCache cache;
+		auto stored = CreateAdditionNode({ CreateDice(1, 20), CreateConstant(5) });
+		auto lookup = CreateAdditionNode({ CreateDice(1, 20), CreateConstant(5) });
+
+		EXPECT_EQ(cache.Find(*lookup), nullptr);
+		cache.Insert(*stored, Distribution{ {6, 0.5}, {25, 0.5} });
+		auto found = cache.Find(*lookup);
+
+		ASSERT_NE(found, nullptr);
+		EXPECT_DOUBLE_EQ((*found)[25], 0.5);
+		EXPECT_EQ(cache.Find(*CreateAdditionNode({ CreateDice(1, 20), CreateConstant(4) })), nullptr);
+
+		auto statistics = cache.GetStatistics();
+		EXPECT_EQ(statistics.Hits, 1u);
+		EXPECT_EQ(statistics.Misses, 2u);
+		EXPECT_EQ(statistics.Evictions, 0u);
+		EXPECT_EQ(statistics.Size, 1u);
+	}
+
+	TEST_F(DistributionCacheTest, EvictsLeastRecentlyUsed)
+	{
+		DistributionCache cache(2);
+		auto a = CreateDice(1, 4);
+		auto b = CreateDice(1, 6);
+		auto c = CreateDice(1, 8);
+
+		cache.Insert(*a, Distribution{ {1, 1.0} });
+		cache.Insert(*b, Distribution{ {2, 1.0} });
+		ASSERT_NE(cache.Find(*a), nullptr); // a is now more recent than b
+		cache.Insert(*c, Distribution{ {3, 1.0} });
+
+		EXPECT_NE(cache.Find(*a), nullptr);
+		EXPECT_EQ(cache.Find(*b), nullptr);
+		EXPECT_NE(cache.Find(*c), nullptr);
+		EXPECT_EQ(cache.GetStatistics().Evictions, 1u);
+		EXPECT_EQ(cache.GetStatistics().Size, 2u);
+	}
+
+	TEST_F(DistributionCacheTest, ReinsertReplacesWithoutGrowing)
+	{
+		DistributionCache cache(4);
+		auto node = CreateDice(2, 6);
+
+		cache.Insert(*node, Distribution{ {1, 1.0} });
+		cache.Insert(*CreateDice(2, 6), Distribution{ {7, 1.0} });
+
+		EXPECT_EQ(cache.GetStatistics().Size, 1u);
+		EXPECT_DOUBLE_EQ((*cache.Find(*node))[7], 1.0);
+	}
+
+	TEST_F(DistributionCacheTest, NodesWithoutSharedOwnershipAreNotCached)
+	{
+		DistributionCache cache;
+		Expressions::DiceNode node(1, 6);
+
+		cache.Insert(node, Distribution{ {1, 1.0} });
+
+		EXPECT_EQ(cache.GetStatistics().Size, 0u);
+	}
+
+	TEST_F(DistributionCacheTest, VisitorReusesCachedSubexpressions)
+	{
+		auto cache = std::make_shared<DistributionCache>();
+		ConvolutionAstVisitor visitor(Convolver(), nullptr, cache);
+
+		auto first = CreateAdditionNode({ CreateDice(1, 20), CreateConstant(5) });
+		first->Accept(visitor);
+		const Distribution expected = visitor.GetDistribution();
+		const auto afterFirst = cache->GetStatistics();
+		EXPECT_EQ(afterFirst.Hits, 0u);
+
+		// A separately built expression containing the same sum hits the cache for it.
+		auto second = CreateSubtractionNode({ CreateAdditionNode({ CreateDice(1, 20), CreateConstant(5) }), CreateDice(1, 4) });
+		second->Accept(visitor);
+		EXPECT_EQ(cache->GetStatistics().Hits, afterFirst.Hits + 1);
+
+		first->Accept(visitor);
+		EXPECT_EQ(cache->GetStatistics().Hits, afterFirst.Hits + 2);
+		ASSERT_EQ(visitor.GetDistribution().Size(), expected.Size());
+		for (const auto& [value, probability] : expected)
+		{
+			EXPECT_EQ(visitor.GetDistribution()[value], probability);
+		}
+	}
+}
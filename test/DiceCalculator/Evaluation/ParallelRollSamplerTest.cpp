@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+
+#include "DiceCalculator/Evaluation/ParallelRollSampler.h"
+#include "DiceCalculator/ThreadPool.h"
+
+#include "DiceCalculator/TestUtilities.h"
+
+#include <chrono>
+#include <memory>
+
+using namespace DiceCalculator;
+using namespace DiceCalculator::Evaluation;
+using namespace DiceCalculator::TestUtilities;
+
+namespace DiceCalculator::Evaluation
+{
+	class ParallelRollSamplerTest : public TestHelpers
+	{
+	};
+
+	TEST_F(ParallelRollSamplerTest, ResultDoesNotDependOnThreadCount)
+	{
+		auto node = CreateAttackRollNode(
+			CreateAdditionNode({ CreateAdvantageNode(CreateDice(1, 20)), CreateConstant(4) }),
+			CreateSubtractionNode({ CreateDice(2, 6), CreateConstant(-8) }));
+
+		// 10,000 samples in blocks of 512 leave a partial last block.
+		const Distribution sequential = ParallelRollSampler(99, nullptr, 512).Sample(*node, 10000);
+		for (std::size_t threads : { 1u, 3u, 8u })
+		{
+			const Distribution parallel = ParallelRollSampler(99, std::make_shared<ThreadPool>(threads), 512).Sample(*node, 10000);
+			ASSERT_EQ(parallel.Size(), sequential.Size()) << threads << " threads";
+			for (const auto& [value, probability] : sequential)
+			{
+				EXPECT_EQ(parallel[value], probability) << threads << " threads, value " << value;
+			}
+		}
+
+		const Distribution otherSeed = ParallelRollSampler(100, nullptr, 512).Sample(*node, 10000);
+		EXPECT_NE(otherSeed[1], sequential[1]);
+	}
+
+	TEST_F(ParallelRollSamplerTest, AdaptiveResultDoesNotDependOnThreadCount)
+	{
+		auto node = CreateDice(1, 20);
+
+		ParallelRollSampler::Precision precision;
+		precision.MaxStandardError = 0.001;
+		precision.TimeBudget = std::chrono::hours(1);
+		const auto sequential = ParallelRollSampler(42).SampleAdaptive(*node, precision);
+		ASSERT_TRUE(sequential.PrecisionMet);
+		for (std::size_t threads : { 1u, 2u, 8u, 16u })
+		{
+			const auto parallel = ParallelRollSampler(42, std::make_shared<ThreadPool>(threads)).SampleAdaptive(*node, precision);
+			EXPECT_EQ(parallel.Samples, sequential.Samples) << threads << " threads";
+			for (const auto& [value, probability] : sequential.Result)
+			{
+				EXPECT_EQ(parallel.Result[value], probability) << threads << " threads, value " << value;
+			}
+		}
+	}
+
+	TEST_F(ParallelRollSamplerTest, SampleApproachesExactDistribution)
+	{
+		auto node = CreateAdditionNode({ CreateDice(1, 6), CreateDice(1, 4) });
+
+		const Distribution dist = ParallelRollSampler(7, std::make_shared<ThreadPool>(2)).Sample(*node, 200000);
+
+		ASSERT_EQ(dist.Size(), 9u);
+		EXPECT_NEAR(dist[2], 1.0 / 24.0, 0.01);
+		EXPECT_NEAR(dist[6], 4.0 / 24.0, 0.01);
+		EXPECT_NEAR(dist[10], 1.0 / 24.0, 0.01);
+	}
+
+	TEST_F(ParallelRollSamplerTest, AdaptiveSamplingStopsOnceStandardErrorIsMet)
+	{
+		auto node = CreateDice(1, 2);
+		const ParallelRollSampler sampler(3, nullptr, 1000);
+
+		ParallelRollSampler::Precision precision;
+		precision.MinSamples = 0;
+		precision.MaxStandardError = 0.005;
+		const auto estimate = sampler.SampleAdaptive(*node, precision);
+
+		// p = 1/2 needs 0.25 / 0.005^2 = 10,000 samples; doubling rounds may overshoot by a factor of two.
+		EXPECT_TRUE(estimate.PrecisionMet);
+		EXPECT_GE(estimate.Samples, 9000u);
+		EXPECT_LE(estimate.Samples, 20000u);
+		EXPECT_LE(estimate.MaxStandardError, 0.005);
+		EXPECT_NEAR(estimate.GetStandardError(1), estimate.MaxStandardError, 1e-4);
+		EXPECT_NEAR(estimate.Result[1], 0.5, 0.02);
+
+		const auto repeated = sampler.SampleAdaptive(*node, precision);
+		EXPECT_EQ(repeated.Samples, estimate.Samples);
+		EXPECT_EQ(repeated.Result[1], estimate.Result[1]);
+	}
+
+	TEST_F(ParallelRollSamplerTest, AdaptiveSamplingHonoursKsBoundAndSampleCap)
+	{
+		auto node = CreateAdditionNode({ CreateDice(3, 6), CreateConstant(1) });
+		const ParallelRollSampler sampler(11, std::make_shared<ThreadPool>(2), 1000);
+
+		ParallelRollSampler::Precision precision;
+		precision.MaxStandardError = 0.0;
+		precision.MaxKsDistance = 0.01;
+		const auto estimate = sampler.SampleAdaptive(*node, precision);
+		EXPECT_TRUE(estimate.PrecisionMet);
+		EXPECT_LE(estimate.KsDistance, 0.01);
+
+		precision.MaxKsDistance = 0.0001;
+		precision.MaxSamples = 50000;
+		const auto capped = sampler.SampleAdaptive(*node, precision);
+		EXPECT_FALSE(capped.PrecisionMet);
+		EXPECT_EQ(capped.Samples, 50000u);
+		EXPECT_GT(capped.KsDistance, 0.0001);
+	}
+}
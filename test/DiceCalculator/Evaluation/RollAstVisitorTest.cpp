@@ -191,6 +191,21 @@ namespace DiceCalculator::Evaluation
 		EXPECT_EQ(records[2].RolledValue, 5);
 	}
 
+	TEST_F(RollVisitorTest, AdvantageKeepsDiceOfFirstBestAttempt)
+	{
+		MockRandom rnd({ 1, 2, 6, 5, 4, 3, 6, 5 });
+		RollAstVisitor visitor(rnd);
+
+		// ADV(2d6, 4) == ADV(1+2, 6+5, 4+3, 6+5) == 11, the tie keeps the dice of the second attempt.
+		CreateAdvantageNode(CreateDice(2, 6), CreateConstant(4))->Accept(visitor);
+
+		EXPECT_EQ(visitor.GetResult(), 11);
+		const auto& records = visitor.GetDiceRecords();
+		ASSERT_EQ(records.size(), 2);
+		EXPECT_EQ(records[0].RolledValue, 6);
+		EXPECT_EQ(records[1].RolledValue, 5);
+	}
+
 	TEST_F(RollVisitorTest, ComparisonOfTwoConstants)
 	{
 		MockRandom rnd({ 1, 2, 3, 4, 5 });
@@ -375,4 +390,38 @@ namespace DiceCalculator::Evaluation
 		EXPECT_EQ(visitor.GetDiceRecords()[0].Sides, 20);
 		EXPECT_EQ(visitor.GetDiceRecords()[0].RolledValue, 1);
 	}
-}
\ No newline at end of file
+
+	/// <summary>
+	/// Testing expression: AttackRoll(1d20 - 5 - 1d8, 15) without dice records. The mocked d20 roll is 20, so the crit. hit must still be detected.
+	/// </summary>
+	TEST_F(RollVisitorTest, TotalsOnlyAttackRollCriticalHit)
+	{
+		MockRandom rnd({ 20, 3 });
+		RollAstVisitor visitor(rnd, RollAstVisitor::Tracking::TotalsOnly);
+
+		auto attackOperand = CreateSubtractionNode({ CreateDice(1, 20), CreateConstant(5), CreateDice(1, 8) });
+		auto attackRoll = CreateAttackRollNode(attackOperand, CreateConstant(15));
+
+		attackRoll->Accept(visitor);
+		EXPECT_EQ(visitor.GetResult(), 1);
+		EXPECT_TRUE(visitor.GetDiceRecords().empty());
+		EXPECT_EQ(visitor.GetFirstD20(), 20);
+	}
+
+	/// <summary>
+	/// Testing expression: AttackRoll(Dis(1d20 + 1), 1) without dice records. The kept d20 is the critical miss.
+	/// </summary>
+	TEST_F(RollVisitorTest, TotalsOnlyAttackRollDisadvantageMiss)
+	{
+		MockRandom rnd({ 1, 20 });
+		RollAstVisitor visitor(rnd, RollAstVisitor::Tracking::TotalsOnly);
+
+		auto attackOperand = CreateDisadvantageNode(CreateAdditionNode({ CreateDice(1, 20), CreateConstant(1) }));
+		auto attackRoll = CreateAttackRollNode(attackOperand, CreateConstant(1));
+
+		attackRoll->Accept(visitor);
+		EXPECT_EQ(visitor.GetResult(), 0);
+		EXPECT_TRUE(visitor.GetDiceRecords().empty());
+		EXPECT_EQ(visitor.GetFirstD20(), 1);
+	}
+}
@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+
+#include "DiceCalculator/Evaluation/RollProgram.h"
+#include "DiceCalculator/Evaluation/RollProgramCompiler.h"
+#include "DiceCalculator/Xoshiro256Random.h"
+
+#include "DiceCalculator/TestUtilities.h"
+
+#include <map>
+#include <memory>
+#include <vector>
+
+using namespace DiceCalculator;
+using namespace DiceCalculator::Evaluation;
+using namespace DiceCalculator::TestUtilities;
+
+namespace DiceCalculator::Evaluation
+{
+	// MockRandom hands out its values in order, and a run draws one die for all samples before the
+	// next die, so the values below are listed die by die.
+	class RollProgramTest : public TestHelpers
+	{
+	protected:
+		static std::vector<int> Run(const DiceCalculator::Expressions::DiceAst& node, IRandom& random, std::size_t samples)
+		{
+			const RollProgram program = RollProgramCompiler::Compile(node);
+			RollProgram::Workspace workspace;
+			std::vector<int> results(samples);
+			program.Run(random, results, workspace);
+			return results;
+		}
+	};
+
+	TEST_F(RollProgramTest, CompilesToLinearCodeAndReusesRegisters)
+	{
+		// ((1d6 + 2) + 1d4) + 3 as a single flattened addition.
+		auto node = CreateAdditionNode({ CreateDice(1, 6), CreateConstant(2), CreateDice(1, 4), CreateConstant(3) });
+		const RollProgram program = RollProgramCompiler::Compile(*node);
+
+		using OpCode = RollProgram::OpCode;
+		std::vector<OpCode> codes;
+		for (const auto& instruction : program.GetInstructions())
+		{
+			codes.push_back(instruction.Code);
+		}
+		EXPECT_EQ(codes, (std::vector<OpCode>{ OpCode::Dice, OpCode::Constant, OpCode::Add, OpCode::Dice, OpCode::Add, OpCode::Constant, OpCode::Add }));
+		EXPECT_EQ(program.GetRegisterCount(), 2u);
+		EXPECT_FALSE(program.TracksD20());
+	}
+
+	TEST_F(RollProgramTest, ConstantFillsEverySample)
+	{
+		MockRandom rnd({}); // not used
+		EXPECT_EQ(Run(*CreateConstant(42), rnd, 3), (std::vector<int>{ 42, 42, 42 }));
+	}
+
+	TEST_F(RollProgramTest, RunsConstantsAndDiceColumnByColumn)
+	{
+		// Two samples of 2d6 - 1: the first die of both samples, then the second die.
+		MockRandom rnd({ 1, 2, 3, 4 });
+		EXPECT_EQ(Run(*CreateSubtractionNode({ CreateDice(2, 6), CreateConstant(1) }), rnd, 2), (std::vector<int>{ 3, 5 }));
+	}
+
+	TEST_F(RollProgramTest, ArithmeticAndComparisonWorkPerSample)
+	{
+		// (1d6 + 2 - 1) >= 1d4 with left rolls { 6, 1 } and right rolls { 3, 4 }
+		MockRandom rnd({ 6, 1, 3, 4 });
+		auto node = CreateGreaterThanOrEqualNode(
+			CreateSubtractionNode({ CreateAdditionNode({ CreateDice(1, 6), CreateConstant(2) }), CreateConstant(1) }),
+			CreateDice(1, 4));
+
+		EXPECT_EQ(Run(*node, rnd, 2), (std::vector<int>{ 1, 0 }));
+	}
+
+	TEST_F(RollProgramTest, AdvantageAndDisadvantagePickPerSample)
+	{
+		MockRandom advantageRandom({ 1, 5, 3, 4, 2, 3 });
+		EXPECT_EQ(Run(*CreateAdvantageNode(CreateDice(1, 6)), advantageRandom, 3), (std::vector<int>{ 4, 5, 3 }));
+
+		MockRandom disadvantageRandom({ 1, 5, 3, 4, 2, 3 });
+		EXPECT_EQ(Run(*CreateDisadvantageNode(CreateDice(1, 6)), disadvantageRandom, 3), (std::vector<int>{ 1, 2, 3 }));
+	}
+
+	TEST_F(RollProgramTest, AttackRollAppliesCriticalsPerSample)
+	{
+		// d20 + 5 vs AC 5: natural 20 hits, natural 1 misses although 6 >= 5, 10 hits normally.
+		MockRandom rnd({ 20, 1, 10 });
+		auto node = CreateAttackRollNode(CreateAdditionNode({ CreateDice(1, 20), CreateConstant(5) }), CreateConstant(5));
+
+		EXPECT_EQ(Run(*node, rnd, 3), (std::vector<int>{ 1, 0, 1 }));
+	}
+
+	TEST_F(RollProgramTest, AttackRollUsesTheKeptD20)
+	{
+		// Advantage keeps the second roll of sample 0 (a natural 20) and the first of sample 1 (a 10).
+		MockRandom rnd({ 5, 10, 20, 2 });
+		auto node = CreateAttackRollNode(CreateAdvantageNode(CreateDice(1, 20)), CreateConstant(30));
+		EXPECT_TRUE(RollProgramCompiler::Compile(*node).TracksD20());
+
+		EXPECT_EQ(Run(*node, rnd, 2), (std::vector<int>{ 1, 0 }));
+	}
+
+	TEST_F(RollProgramTest, SamplesApproachExactDistribution)
+	{
+		Xoshiro256Random rnd(17);
+		const std::vector<int> results = Run(*CreateAdditionNode({ CreateDice(1, 6), CreateDice(1, 4) }), rnd, 200000);
+
+		std::map<int, double> frequencies;
+		for (const int value : results)
+		{
+			frequencies[value] += 1.0 / static_cast<double>(results.size());
+		}
+
+		// 1d6 + 1d4 has totals 2..10; 5, 6 and 7 can each be made in 4 of 24 ways.
+		ASSERT_EQ(frequencies.size(), 9u);
+		EXPECT_NEAR(frequencies[2], 1.0 / 24.0, 0.01);
+		EXPECT_NEAR(frequencies[6], 4.0 / 24.0, 0.01);
+		EXPECT_NEAR(frequencies[10], 1.0 / 24.0, 0.01);
+	}
+}
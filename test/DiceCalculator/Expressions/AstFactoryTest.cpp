@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+
+#include "DiceCalculator/Expressions/AstFactory.h"
+#include "DiceCalculator/Evaluation/ConvolutionAstVisitor.h"
+#include "DiceCalculator/Parsing/BoostSpiritParser.h"
+#include "DiceCalculator/Operators/Registry.h"
+#include "DiceCalculator/Transforms/AssociativeFlattener.h"
+#include "DiceCalculator/TestUtilities.h"
+
+namespace DiceCalculator::Expressions
+{
+	class AstFactoryTest : public TestUtilities::TestHelpers
+	{
+	public:
+		std::shared_ptr<Operators::Registry> Registry = std::make_shared<Operators::Registry>();
+	};
+
+	TEST_F(AstFactoryTest, EqualLeavesAreTheSameNode)
+	{
+		AstFactory factory;
+
+		EXPECT_EQ(factory.MakeConstant(5), factory.MakeConstant(5));
+		EXPECT_NE(factory.MakeConstant(5), factory.MakeConstant(6));
+		EXPECT_EQ(factory.MakeDice(2, 6), factory.MakeDice(2, 6));
+		EXPECT_NE(factory.MakeDice(2, 6), factory.MakeDice(6, 2));
+	}
+
+	TEST_F(AstFactoryTest, EqualOperatorTreesAreTheSameNode)
+	{
+		AstFactory factory;
+
+		auto a = factory.MakeOperator(std::make_shared<Operators::Addition>(), { factory.MakeDice(1, 20), factory.MakeConstant(5) });
+		// Operands built elsewhere are interned too.
+		auto b = factory.MakeOperator(std::make_shared<Operators::Addition>(), { CreateDice(1, 20), CreateConstant(5) });
+		auto c = factory.MakeOperator(std::make_shared<Operators::Subtraction>(), { CreateDice(1, 20), CreateConstant(5) });
+		auto d = factory.MakeOperator(std::make_shared<Operators::Advantage>(Operators::Advantage::Mode::Advantage), { a });
+		auto e = factory.MakeOperator(std::make_shared<Operators::Advantage>(Operators::Advantage::Mode::Disadvantage), { a });
+
+		EXPECT_EQ(a, b);
+		EXPECT_NE(a, c);
+		EXPECT_NE(d, e);
+		EXPECT_EQ(d->GetOperands()[0], e->GetOperands()[0]);
+		EXPECT_EQ(factory.Intern(CreateAdditionNode({ CreateDice(1, 20), CreateConstant(5) })), a);
+	}
+
+	TEST_F(AstFactoryTest, ForgetsNodesNobodyUses)
+	{
+		AstFactory factory;
+		auto kept = factory.MakeDice(1, 6);
+		factory.MakeOperator(std::make_shared<Operators::Addition>(), { factory.MakeDice(1, 8), factory.MakeConstant(1) });
+
+		EXPECT_EQ(factory.GetNodeCount(), 1u);
+		EXPECT_EQ(factory.MakeDice(1, 6), kept);
+	}
+
+	TEST_F(AstFactoryTest, ParserSharesRepeatedSubexpressions)
+	{
+		Parsing::BoostSpiritParser parser(Registry);
+
+		auto ast = std::dynamic_pointer_cast<OperatorNode>(parser.Parse("ADV(1d20 + 5) >= 1d20 + 5"));
+
+		ASSERT_NE(ast, nullptr);
+		auto advantage = std::dynamic_pointer_cast<OperatorNode>(ast->GetOperands()[0]);
+		ASSERT_NE(advantage, nullptr);
+		EXPECT_EQ(advantage->GetOperands()[0], ast->GetOperands()[1]);
+
+		// Flattening keeps the sharing intact.
+		auto flattened = std::dynamic_pointer_cast<OperatorNode>(Transforms::AssociativeFlattener::Flatten(parser.Parse("ADV(1d20 + 5 + 1) >= 1d20 + 5 + 1")));
+		auto flattenedAdvantage = std::dynamic_pointer_cast<OperatorNode>(flattened->GetOperands()[0]);
+		EXPECT_EQ(flattenedAdvantage->GetOperands()[0], flattened->GetOperands()[1]);
+	}
+
+	TEST_F(AstFactoryTest, SharedSubtreesAreEvaluatedOncePerEvaluation)
+	{
+		AstFactory factory;
+		auto shared = factory.MakeOperator(std::make_shared<Operators::Addition>(), { factory.MakeDice(1, 20), factory.MakeConstant(5) });
+		auto dag = factory.MakeOperator(std::make_shared<Operators::Comparison>(Operators::Comparison::Mode::GreaterThanOrEqual),
+			{ factory.MakeOperator(std::make_shared<Operators::Advantage>(Operators::Advantage::Mode::Advantage), { shared }), shared });
+		auto tree = CreateGreaterThanOrEqualNode(CreateAdvantageNode(CreateAdditionNode({ CreateDice(1, 20), CreateConstant(5) })),
+			CreateAdditionNode({ CreateDice(1, 20), CreateConstant(5) }));
+
+		// The cache counts every evaluated node: root, ADV and the sum.
+		auto dagCache = std::make_shared<Evaluation::DistributionCache>();
+		Evaluation::ConvolutionAstVisitor dagVisitor(Evaluation::Convolver(), std::make_shared<ThreadPool>(2), dagCache);
+		dag->Accept(dagVisitor);
+		EXPECT_EQ(dagCache->GetStatistics().Misses, 3u);
+		EXPECT_EQ(dagCache->GetStatistics().Hits, 0u);
+
+		// The plain tree reaches the second copy of the sum separately.
+		auto treeCache = std::make_shared<Evaluation::DistributionCache>();
+		Evaluation::ConvolutionAstVisitor treeVisitor(Evaluation::Convolver(), nullptr, treeCache);
+		tree->Accept(treeVisitor);
+		EXPECT_EQ(treeCache->GetStatistics().Misses + treeCache->GetStatistics().Hits, 4u);
+
+		const auto& expected = treeVisitor.GetDistribution();
+		ASSERT_EQ(dagVisitor.GetDistribution().Size(), expected.Size());
+		for (const auto& [value, probability] : expected)
+		{
+			EXPECT_EQ(dagVisitor.GetDistribution()[value], probability);
+		}
+	}
+}
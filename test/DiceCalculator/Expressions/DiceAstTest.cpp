@@ -91,4 +91,45 @@ namespace DiceCalculator::Expressions
 
         EXPECT_TRUE(adv1->IsEqual(*adv2));
     }
-}
\ No newline at end of file
+
+    // Structural hash agrees with IsEqual
+    TEST_F(DiceAstTest, StructurallyEqualTreesHashEqually)
+    {
+        auto build = [this]()
+        {
+            return CreateGreaterThanNode(
+                CreateAdditionNode({ CreateDice(1, 20), CreateConstant(5), CreateAdvantageNode(CreateDice(1, 4)) }),
+                CreateConstant(15));
+        };
+        auto a = build();
+        auto b = build();
+
+        ASSERT_TRUE(a->IsEqual(*b));
+        EXPECT_EQ(a->GetHash(), b->GetHash());
+    }
+
+    TEST_F(DiceAstTest, StructurallyDifferentTreesHashDifferently)
+    {
+        std::vector<std::shared_ptr<DiceAst>> trees = {
+            CreateConstant(5),
+            CreateConstant(6),
+            CreateDice(1, 6),
+            CreateDice(6, 1),
+            CreateAdditionNode({ CreateDice(1, 6), CreateConstant(3) }),
+            CreateAdditionNode({ CreateConstant(3), CreateDice(1, 6) }),
+            CreateSubtractionNode({ CreateDice(1, 6), CreateConstant(3) }),
+            CreateAdvantageNode(CreateDice(1, 20)),
+            CreateDisadvantageNode(CreateDice(1, 20)),
+            CreateGreaterThanNode(CreateDice(1, 20), CreateConstant(10)),
+            CreateLessThanNode(CreateDice(1, 20), CreateConstant(10)),
+        };
+
+        for (std::size_t i = 0; i < trees.size(); ++i)
+        {
+            for (std::size_t j = i + 1; j < trees.size(); ++j)
+            {
+                EXPECT_NE(trees[i]->GetHash(), trees[j]->GetHash()) << "trees " << i << " and " << j;
+            }
+        }
+    }
+}
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include "DiceCalculator/Expressions/FlatAst.h"
+#include "DiceCalculator/Expressions/AstFactory.h"
+#include "DiceCalculator/Parsing/BoostSpiritParser.h"
+#include "DiceCalculator/Operators/Registry.h"
+#include "DiceCalculator/TestUtilities.h"
+
+#include <memory>
+#include <vector>
+
+namespace DiceCalculator::Expressions
+{
+	class FlatAstTest : public TestUtilities::TestHelpers
+	{
+	public:
+		std::shared_ptr<Operators::Registry> Registry = std::make_shared<Operators::Registry>();
+	};
+
+	TEST_F(FlatAstTest, NodesAreStoredInPostOrder)
+	{
+		// ADV(2d6 + 3) - 4
+		FlatAst flat(*CreateSubtractionNode({ CreateAdvantageNode(CreateAdditionNode({ CreateDice(2, 6), CreateConstant(3) })), CreateConstant(4) }));
+
+		const auto nodes = flat.GetNodes();
+		ASSERT_EQ(nodes.size(), 6u);
+		EXPECT_EQ(nodes[0].Kind, FlatAst::NodeKind::Dice);
+		EXPECT_EQ(nodes[0].Value, 2);
+		EXPECT_EQ(nodes[0].Sides, 6);
+		EXPECT_EQ(nodes[1].Kind, FlatAst::NodeKind::Constant);
+		EXPECT_EQ(nodes[1].Value, 3);
+		EXPECT_EQ(nodes[2].Kind, FlatAst::NodeKind::Operator);
+		EXPECT_EQ(std::vector<std::uint32_t>(flat.GetOperands(nodes[2]).begin(), flat.GetOperands(nodes[2]).end()), (std::vector<std::uint32_t>{ 0, 1 }));
+		EXPECT_NE(dynamic_cast<const Operators::Addition*>(&flat.GetOperator(nodes[2])), nullptr);
+		EXPECT_EQ(std::vector<std::uint32_t>(flat.GetOperands(nodes[3]).begin(), flat.GetOperands(nodes[3]).end()), (std::vector<std::uint32_t>{ 2 }));
+		EXPECT_EQ(nodes[4].Value, 4);
+		EXPECT_EQ(&flat.GetRoot(), &nodes[5]);
+		EXPECT_EQ(std::vector<std::uint32_t>(flat.GetOperands(nodes[5]).begin(), flat.GetOperands(nodes[5]).end()), (std::vector<std::uint32_t>{ 3, 4 }));
+		EXPECT_NE(dynamic_cast<const Operators::Subtraction*>(&flat.GetOperator(nodes[5])), nullptr);
+	}
+
+	TEST_F(FlatAstTest, SharedSubtreesAndEqualOperatorsAreStoredOnce)
+	{
+		Parsing::BoostSpiritParser parser(Registry);
+
+		// The parser shares 1d20 + 5; each + node still got its own operator instance.
+		FlatAst flat(*parser.Parse("ADV(1d20 + 5) >= 1d20 + 5 + 1"));
+
+		// 1d20, 5, +, ADV, 1, + and >=.
+		EXPECT_EQ(flat.GetNodes().size(), 7u);
+		EXPECT_EQ(flat.GetOperators().size(), 3u);
+		const auto root = flat.GetOperands(flat.GetRoot());
+		const auto& advantage = flat.GetNodes()[root[0]];
+		const auto& sum = flat.GetNodes()[root[1]];
+		EXPECT_EQ(flat.GetOperands(advantage)[0], flat.GetOperands(sum)[0]);
+		EXPECT_NE(advantage.Operator, sum.Operator);
+		EXPECT_EQ(flat.GetNodes()[flat.GetOperands(sum)[0]].Operator, sum.Operator);
+	}
+
+	TEST_F(FlatAstTest, ToAstRebuildsAnEqualTree)
+	{
+		Parsing::BoostSpiritParser parser(Registry);
+		const auto ast = parser.Parse("(1d8 + (ADV(2d4) - AttackRoll(1d20, 13))) >= DIS(2d6) + 3");
+
+		AstFactory factory;
+		const auto rebuilt = FlatAst(*ast).ToAst(factory);
+
+		ASSERT_NE(rebuilt, nullptr);
+		EXPECT_TRUE(rebuilt->IsEqual(*ast));
+		EXPECT_EQ(rebuilt->GetHash(), ast->GetHash());
+		EXPECT_EQ(factory.Intern(ast), rebuilt);
+		EXPECT_EQ(FlatAst().ToAst(factory), nullptr);
+	}
+
+	TEST_F(FlatAstTest, LongGeneratedSumIsOneBlockOfNodes)
+	{
+		// A left-deep chain of 5000 sums, as the parser builds for long expressions.
+		std::shared_ptr<DiceAst> ast = CreateDice(1, 6);
+		for (int i = 0; i < 5000; ++i)
+		{
+			ast = CreateAdditionNode({ ast, CreateDice(1, 6 + i % 3) });
+		}
+
+		FlatAst flat(*ast);
+
+		EXPECT_EQ(flat.GetNodes().size(), 10001u);
+		EXPECT_EQ(flat.GetOperators().size(), 1u);
+		long long rolls = 0;
+		for (const auto& node : flat.GetNodes())
+		{
+			rolls += node.Kind == FlatAst::NodeKind::Dice ? node.Value : 0;
+		}
+		EXPECT_EQ(rolls, 5001);
+	}
+}
@@ -5,6 +5,8 @@
 #include "DiceCalculator/TestUtilities.h"
 
 #include <string>
+#include <thread>
+#include <vector>
 
 namespace DiceCalculator::Parsing
 {
@@ -147,5 +149,54 @@ namespace DiceCalculator::Parsing
 		auto reparsedAst = parser.Parse(reconstructed);
 		EXPECT_TRUE(reparsedAst->IsEqual(*ast)) << "Re-parsed AST did not match original AST.";
 	}
-}
 
+	TEST_F(BoostSpiritParserTest, PicksUpOperatorsRegisteredAfterFirstParse)
+	{
+		BoostSpiritParser parser(Registry);
+		EXPECT_TRUE(parser.Parse("1d6 + 2")->IsEqual(*CreateAdditionNode({ CreateDice(1, 6), CreateConstant(2) })));
+		EXPECT_THROW(parser.Parse("1d6 plus 2"), std::runtime_error);
+
+		Registry->Register({ "plus", Operators::Arity::Binary, []() { return std::make_shared<Operators::Addition>(); } });
+
+		auto ast = parser.Parse("1d6 plus 2");
+		ASSERT_NE(ast, nullptr);
+		EXPECT_TRUE(ast->IsEqual(*CreateAdditionNode({ CreateDice(1, 6), CreateConstant(2) })));
+	}
+
+	TEST_F(BoostSpiritParserTest, ParsesConcurrently)
+	{
+		const BoostSpiritParser parser(Registry);
+		const std::vector<std::string> inputs = { "1d8 + 1d20 > 10", "ADV(1d20 + 5) >= 15", "AttackRoll(1d20, 13)", "(1d8 + (2d4 - 3)) >= 5" };
+		std::vector<std::shared_ptr<Expressions::DiceAst>> expected;
+		for (const auto& input : inputs)
+		{
+			expected.push_back(parser.Parse(input));
+		}
+
+		std::vector<int> mismatches(4, 0);
+		std::vector<std::thread> threads;
+		for (std::size_t t = 0; t < mismatches.size(); ++t)
+		{
+			threads.emplace_back([&, t]()
+				{
+					for (int i = 0; i < 200; ++i)
+					{
+						const std::size_t index = (t + i) % inputs.size();
+						if (!parser.Parse(inputs[index])->IsEqual(*expected[index]))
+						{
+							++mismatches[t];
+						}
+					}
+				});
+		}
+		for (auto& thread : threads)
+		{
+			thread.join();
+		}
+
+		for (int count : mismatches)
+		{
+			EXPECT_EQ(count, 0);
+		}
+	}
+}
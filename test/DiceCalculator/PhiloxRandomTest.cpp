@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "DiceCalculator/PhiloxRandom.h"
+
+namespace DiceCalculator
+{
+	TEST(PhiloxRandomTest, GenerateMatchesKnownAnswers)
+	{
+		// Known-answer vectors published with the Random123 reference implementation.
+		EXPECT_EQ(PhiloxRandom::Generate({ 0, 0, 0, 0 }, { 0, 0 }),
+			(PhiloxRandom::Counter{ 0x6627e8d5u, 0xe169c58du, 0xbc57ac4cu, 0x9b00dbd8u }));
+		EXPECT_EQ(PhiloxRandom::Generate({ 0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu }, { 0xffffffffu, 0xffffffffu }),
+			(PhiloxRandom::Counter{ 0x408f276du, 0x41c83b0eu, 0xa20bc7c6u, 0x6d5451fdu }));
+		EXPECT_EQ(PhiloxRandom::Generate({ 0x243f6a88u, 0x85a308d3u, 0x13198a2eu, 0x03707344u }, { 0xa4093822u, 0x299f31d0u }),
+			(PhiloxRandom::Counter{ 0xd16cfe09u, 0x94fdccebu, 0x5001e420u, 0x24126ea1u }));
+	}
+
+	TEST(PhiloxRandomTest, SameSeedAndStreamRepeatAndOtherStreamsDiffer)
+	{
+		PhiloxRandom first(1234, 7);
+		PhiloxRandom second(1234, 7);
+		PhiloxRandom otherStream(1234, 8);
+		PhiloxRandom otherSeed(1235, 7);
+
+		int differentStream = 0;
+		int differentSeed = 0;
+		for (int i = 0; i < 64; ++i)
+		{
+			const std::uint32_t value = first.NextUInt32();
+			EXPECT_EQ(value, second.NextUInt32());
+			differentStream += value != otherStream.NextUInt32() ? 1 : 0;
+			differentSeed += value != otherSeed.NextUInt32() ? 1 : 0;
+		}
+		EXPECT_GT(differentStream, 60);
+		EXPECT_GT(differentSeed, 60);
+	}
+
+	TEST(PhiloxRandomTest, BoundedValuesCoverRangeUniformly)
+	{
+		PhiloxRandom random(42);
+		std::vector<int> faces(60000);
+		random.Fill(faces, 1, 6);
+
+		std::array<int, 6> counts = {};
+		for (const int face : faces)
+		{
+			ASSERT_GE(face, 1);
+			ASSERT_LE(face, 6);
+			++counts[static_cast<std::size_t>(face - 1)];
+		}
+		for (const int count : counts)
+		{
+			EXPECT_NEAR(count, 10000, 500);
+		}
+
+		EXPECT_EQ(random.NextInt(-3, -3), -3);
+		EXPECT_NO_THROW(random.NextInt(std::numeric_limits<int>::min(), std::numeric_limits<int>::max()));
+	}
+}
@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+#include "DiceCalculator/ThreadPool.h"
+
+namespace DiceCalculator
+{
+	TEST(ThreadPoolTest, ForEachRunsEveryIndexOnce)
+	{
+		ThreadPool pool(4);
+		std::vector<std::atomic<int>> calls(1000);
+
+		pool.ForEach(calls.size(), [&](std::size_t i) { ++calls[i]; });
+
+		for (const auto& count : calls)
+		{
+			EXPECT_EQ(count.load(), 1);
+		}
+	}
+
+	TEST(ThreadPoolTest, NestedForEachDoesNotDeadlock)
+	{
+		// More nested groups than workers: waiting callers must run the unclaimed indices of their own group.
+		ThreadPool pool(2);
+		std::atomic<int> leaves = 0;
+
+		pool.ForEach(8, [&](std::size_t)
+			{
+				pool.ForEach(8, [&](std::size_t)
+					{
+						pool.ForEach(4, [&](std::size_t) { ++leaves; });
+					});
+			});
+
+		EXPECT_EQ(leaves.load(), 8 * 8 * 4);
+	}
+
+	TEST(ThreadPoolTest, ForEachRethrowsAfterAllTasksFinish)
+	{
+		ThreadPool pool(3);
+		std::atomic<int> finished = 0;
+
+		EXPECT_THROW(pool.ForEach(16, [&](std::size_t i)
+			{
+				if (i == 5)
+				{
+					throw std::runtime_error("task failed");
+				}
+				++finished;
+			}), std::runtime_error);
+		EXPECT_EQ(finished.load(), 15);
+	}
+
+	TEST(ThreadPoolTest, SubmittedTasksRunBeforeDestruction)
+	{
+		std::atomic<int> counter = 0;
+		{
+			ThreadPool pool(2);
+			for (int i = 0; i < 100; ++i)
+			{
+				pool.Submit([&]() { ++counter; });
+			}
+		}
+		EXPECT_EQ(counter.load(), 100);
+	}
+}
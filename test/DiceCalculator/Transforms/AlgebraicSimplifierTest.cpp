@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+
+#include "DiceCalculator/Transforms/AlgebraicSimplifier.h"
+#include "DiceCalculator/Evaluation/ConvolutionAstVisitor.h"
+#include "DiceCalculator/Evaluation/CombinationAstVisitor.h"
+#include "DiceCalculator/Parsing/BoostSpiritParser.h"
+#include "DiceCalculator/Operators/Registry.h"
+#include "DiceCalculator/TestUtilities.h"
+
+namespace DiceCalculator::Transforms
+{
+	class AlgebraicSimplifierTest : public DiceCalculator::TestUtilities::TestHelpers
+	{
+	public:
+		std::shared_ptr<Operators::Registry> Registry = std::make_shared<Operators::Registry>();
+	};
+
+	TEST_F(AlgebraicSimplifierTest, FoldsConstantsOfASum)
+	{
+		Parsing::BoostSpiritParser parser(Registry);
+
+		EXPECT_EQ(parser.Reconstruct(AlgebraicSimplifier::Simplify(parser.Parse("1d20 + 5 + 3 - 2"))), "1d20 + 6");
+		EXPECT_EQ(parser.Reconstruct(AlgebraicSimplifier::Simplify(parser.Parse("1d20 + 2 - 5"))), "1d20 - 3");
+		EXPECT_EQ(parser.Reconstruct(AlgebraicSimplifier::Simplify(parser.Parse("1d20 + 2 - 2"))), "1d20");
+		EXPECT_EQ(parser.Reconstruct(AlgebraicSimplifier::Simplify(parser.Parse("4 - 1 + 3"))), "6");
+	}
+
+	TEST_F(AlgebraicSimplifierTest, PoolsDiceOfTheSameSizeAndSign)
+	{
+		auto pooled = AlgebraicSimplifier::Simplify(CreateAdditionNode({ CreateDice(2, 6), CreateDice(1, 20), CreateDice(1, 6) }));
+		EXPECT_TRUE(pooled->IsEqual(*CreateAdditionNode({ CreateDice(3, 6), CreateDice(1, 20) })));
+
+		// 1d8 - 1d4 - (2d4 - 3): the nested difference flips the sign of its subtrahend.
+		auto nested = AlgebraicSimplifier::Simplify(CreateSubtractionNode({
+			CreateDice(1, 8), CreateDice(1, 4), CreateSubtractionNode({ CreateDice(2, 4), CreateConstant(3) }) }));
+		auto expected = CreateSubtractionNode({ CreateAdditionNode({ CreateDice(1, 8), CreateConstant(3) }), CreateDice(3, 4) });
+		EXPECT_TRUE(nested->IsEqual(*expected));
+
+		// Dice of opposite signs are independent and must not cancel.
+		auto difference = CreateSubtractionNode({ CreateDice(1, 6), CreateDice(1, 6) });
+		EXPECT_EQ(AlgebraicSimplifier::Simplify(difference), difference);
+	}
+
+	TEST_F(AlgebraicSimplifierTest, FoldsOtherOperatorsOnConstants)
+	{
+		auto comparison = AlgebraicSimplifier::Simplify(CreateGreaterThanNode(CreateConstant(5), CreateAdditionNode({ CreateConstant(1), CreateConstant(2) })));
+		EXPECT_TRUE(comparison->IsEqual(*CreateConstant(1)));
+
+		auto sum = AlgebraicSimplifier::Simplify(CreateAdditionNode({ CreateAdvantageNode(CreateConstant(4)), CreateDice(1, 6), CreateConstant(1) }));
+		EXPECT_TRUE(sum->IsEqual(*CreateAdditionNode({ CreateDice(1, 6), CreateConstant(5) })));
+
+		// Operands the operator rejects are left for the evaluator to report.
+		auto invalid = CreateAttackRollNode(CreateConstant(15), CreateConstant(10));
+		EXPECT_EQ(AlgebraicSimplifier::Simplify(invalid), invalid);
+	}
+
+	TEST_F(AlgebraicSimplifierTest, SimplifiesInsideOtherOperatorsAndKeepsUnchangedNodes)
+	{
+		auto untouched = CreateAdditionNode({ CreateDice(1, 20), CreateConstant(5) });
+		auto ast = CreateAttackRollNode(CreateAdditionNode({ CreateDice(1, 20), CreateConstant(2), CreateConstant(3) }), untouched);
+
+		auto simplified = AlgebraicSimplifier::Simplify(ast);
+
+		EXPECT_TRUE(simplified->IsEqual(*CreateAttackRollNode(untouched, untouched)));
+		auto attackRoll = std::dynamic_pointer_cast<const Expressions::OperatorNode>(simplified);
+		EXPECT_EQ(attackRoll->GetOperands()[1], untouched);
+		EXPECT_EQ(AlgebraicSimplifier::Simplify(untouched), untouched);
+	}
+
+	TEST_F(AlgebraicSimplifierTest, SimplifiedTreeHasTheSameDistribution)
+	{
+		Parsing::BoostSpiritParser parser(Registry);
+		auto ast = parser.Parse("1d4 + 1d6 - 1 + 1d4 - 2 + 1d6 - 1d4 + ADV(1d2 + 1d2 + 1)");
+		auto simplified = AlgebraicSimplifier::Simplify(ast);
+		EXPECT_EQ(parser.Reconstruct(simplified), "(2d4 + 2d6 + ADV(2d2 + 1)) - 1d4 - 3");
+
+		Evaluation::ConvolutionAstVisitor convolution;
+		ast->Accept(convolution);
+		const Distribution original = convolution.GetDistribution();
+		simplified->Accept(convolution);
+		ASSERT_EQ(convolution.GetDistribution().Size(), original.Size());
+		for (const auto& [value, probability] : original)
+		{
+			EXPECT_NEAR(convolution.GetDistribution()[value], probability, 1e-15) << "at value " << value;
+		}
+
+		Evaluation::CombinationAstVisitor originalCombinations;
+		Evaluation::CombinationAstVisitor simplifiedCombinations;
+		ast->Accept(originalCombinations);
+		simplified->Accept(simplifiedCombinations);
+		const Distribution combined = originalCombinations.GetDistribution();
+		ASSERT_EQ(simplifiedCombinations.GetDistribution().Size(), combined.Size());
+		for (const auto& [value, probability] : combined)
+		{
+			EXPECT_NEAR(simplifiedCombinations.GetDistribution()[value], probability, 1e-12) << "at value " << value;
+		}
+	}
+}
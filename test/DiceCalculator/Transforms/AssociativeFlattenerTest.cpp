@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+#include "DiceCalculator/Transforms/AssociativeFlattener.h"
+#include "DiceCalculator/Evaluation/ConvolutionAstVisitor.h"
+#include "DiceCalculator/Evaluation/CombinationAstVisitor.h"
+#include "DiceCalculator/Evaluation/RollAstVisitor.h"
+#include "DiceCalculator/Parsing/BoostSpiritParser.h"
+#include "DiceCalculator/Operators/Registry.h"
+#include "DiceCalculator/TestUtilities.h"
+
+namespace DiceCalculator::Transforms
+{
+	class AssociativeFlattenerTest : public DiceCalculator::TestUtilities::TestHelpers
+	{
+	public:
+		std::shared_ptr<Operators::Registry> Registry = std::make_shared<Operators::Registry>();
+	};
+
+	TEST_F(AssociativeFlattenerTest, FlattensLeftDeepAdditionChain)
+	{
+		Parsing::BoostSpiritParser parser(Registry);
+		auto ast = parser.Parse("1d4 + 1d6 + 1d8 + 3 + 1d10");
+
+		auto flattened = AssociativeFlattener::Flatten(ast);
+
+		auto expected = CreateAdditionNode({ CreateDice(1, 4), CreateDice(1, 6), CreateDice(1, 8), CreateConstant(3), CreateDice(1, 10) });
+		EXPECT_TRUE(flattened->IsEqual(*expected));
+		EXPECT_EQ(parser.Reconstruct(flattened), "1d4 + 1d6 + 1d8 + 3 + 1d10");
+	}
+
+	TEST_F(AssociativeFlattenerTest, FlattensOnlyTheMinuendOfSubtraction)
+	{
+		// (1d6 - 2) - (1d4 - 1): the subtrahend chain must stay grouped.
+		auto ast = CreateSubtractionNode({
+			CreateSubtractionNode({ CreateDice(1, 6), CreateConstant(2) }),
+			CreateSubtractionNode({ CreateDice(1, 4), CreateConstant(1) }) });
+
+		auto flattened = AssociativeFlattener::Flatten(ast);
+
+		auto expected = CreateSubtractionNode({
+			CreateDice(1, 6), CreateConstant(2),
+			CreateSubtractionNode({ CreateDice(1, 4), CreateConstant(1) }) });
+		EXPECT_TRUE(flattened->IsEqual(*expected));
+	}
+
+	TEST_F(AssociativeFlattenerTest, FlattensInsideOtherOperatorsAndKeepsUnchangedNodes)
+	{
+		auto untouched = CreateAdditionNode({ CreateDice(1, 20), CreateConstant(5) });
+		auto ast = CreateGreaterThanNode(
+			CreateAdditionNode({ CreateAdditionNode({ CreateDice(1, 8), CreateDice(1, 6) }), CreateConstant(2) }),
+			untouched);
+
+		auto flattened = AssociativeFlattener::Flatten(ast);
+
+		auto expected = CreateGreaterThanNode(CreateAdditionNode({ CreateDice(1, 8), CreateDice(1, 6), CreateConstant(2) }), untouched);
+		EXPECT_TRUE(flattened->IsEqual(*expected));
+		auto comparison = std::dynamic_pointer_cast<const Expressions::OperatorNode>(flattened);
+		EXPECT_EQ(comparison->GetOperands()[1], untouched);
+
+		EXPECT_EQ(AssociativeFlattener::Flatten(untouched), untouched);
+	}
+
+	TEST_F(AssociativeFlattenerTest, FlattenedTreeEvaluatesIdenticallyWithAllVisitors)
+	{
+		Parsing::BoostSpiritParser parser(Registry);
+		auto ast = parser.Parse("1d4 + 2d6 - 1 + 1d8 - 1d4 - 2");
+		auto flattened = AssociativeFlattener::Flatten(ast);
+
+		Evaluation::ConvolutionAstVisitor convolution;
+		ast->Accept(convolution);
+		const Distribution original = convolution.GetDistribution();
+		flattened->Accept(convolution);
+		for (const auto& [value, probability] : original)
+		{
+			EXPECT_NEAR(convolution.GetDistribution()[value], probability, 1e-15) << "at value " << value;
+		}
+
+		Evaluation::CombinationAstVisitor combination;
+		ast->Accept(combination);
+		const auto originalCombinations = combination.GetCombinations();
+		flattened->Accept(combination);
+		ASSERT_EQ(combination.GetCombinations().size(), originalCombinations.size());
+		for (std::size_t i = 0; i < originalCombinations.size(); ++i)
+		{
+			EXPECT_EQ(combination.GetCombinations()[i].TotalValue, originalCombinations[i].TotalValue);
+		}
+
+		TestUtilities::MockRandom originalRandom({ 3, 2, 5, 7, 1 });
+		TestUtilities::MockRandom flattenedRandom({ 3, 2, 5, 7, 1 });
+		Evaluation::RollAstVisitor originalRoll(originalRandom);
+		Evaluation::RollAstVisitor flattenedRoll(flattenedRandom);
+		ast->Accept(originalRoll);
+		flattened->Accept(flattenedRoll);
+		EXPECT_EQ(flattenedRoll.GetResult(), originalRoll.GetResult());
+	}
+}
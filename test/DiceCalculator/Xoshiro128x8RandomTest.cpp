@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <stdexcept>
+#include <vector>
+#include "DiceCalculator/PhiloxRandom.h"
+#include "DiceCalculator/Xoshiro128x8Random.h"
+
+namespace DiceCalculator
+{
+	TEST(Xoshiro128x8RandomTest, SameSeedAndStreamRepeatAndOtherStreamsDiffer)
+	{
+		std::vector<int> first(64);
+		std::vector<int> second(64);
+		std::vector<int> otherStream(64);
+		Xoshiro128x8Random(1234, 7).Fill(first, 0, 1 << 30);
+		Xoshiro128x8Random(1234, 7).Fill(second, 0, 1 << 30);
+		Xoshiro128x8Random(1234, 8).Fill(otherStream, 0, 1 << 30);
+
+		EXPECT_EQ(first, second);
+		int different = 0;
+		for (std::size_t i = 0; i < first.size(); ++i)
+		{
+			different += first[i] != otherStream[i] ? 1 : 0;
+		}
+		EXPECT_GT(different, 60);
+	}
+
+	TEST(Xoshiro128x8RandomTest, LanesStartFromPhiloxBlocksOfTheStream)
+	{
+		// Seed and stream both use their high words, so neither is truncated on the way into Philox.
+		const std::uint64_t seed = 0x0123456789abcdefull;
+		const std::uint64_t stream = 0xfedcba9876543210ull;
+		Evaluation::DiceKernels::State state;
+		for (std::size_t lane = 0; lane < Evaluation::DiceKernels::Lanes; ++lane)
+		{
+			const auto block = PhiloxRandom::Generate({ static_cast<std::uint32_t>(lane), 0, 0x76543210u, 0xfedcba98u }, { 0x89abcdefu, 0x01234567u });
+			for (std::size_t word = 0; word < block.size(); ++word)
+			{
+				state.Words[word][lane] = block[word];
+			}
+		}
+
+		std::vector<int> expected(64);
+		Evaluation::DiceKernels::GetRollKernel(Xoshiro128x8Random::InstructionSet::Scalar)(state, 3, 1000, expected.data(), nullptr, expected.size());
+		std::vector<int> sums(64);
+		Xoshiro128x8Random(seed, stream, Xoshiro128x8Random::InstructionSet::Scalar).SumDice(sums, {}, 3, 1000);
+
+		EXPECT_EQ(sums, expected);
+	}
+
+	TEST(Xoshiro128x8RandomTest, SumDiceMatchesScalarKernel)
+	{
+		Xoshiro128x8Random best(42, 3);
+		Xoshiro128x8Random scalar(42, 3, Xoshiro128x8Random::InstructionSet::Scalar);
+		std::vector<int> bestSums(1000);
+		std::vector<int> scalarSums(1000);
+		std::vector<int> bestFirst(1000);
+		std::vector<int> scalarFirst(1000);
+
+		best.SumDice(bestSums, bestFirst, 4, 20);
+		scalar.SumDice(scalarSums, scalarFirst, 4, 20);
+
+		EXPECT_EQ(bestSums, scalarSums);
+		EXPECT_EQ(bestFirst, scalarFirst);
+		for (std::size_t i = 0; i < bestSums.size(); ++i)
+		{
+			EXPECT_GE(bestSums[i], 4);
+			EXPECT_LE(bestSums[i], 80);
+		}
+	}
+
+	TEST(Xoshiro128x8RandomTest, BoundedValuesStayInRange)
+	{
+		Xoshiro128x8Random random(5);
+		std::vector<int> values(100);
+		random.Fill(values, -3, 2);
+		for (const int value : values)
+		{
+			EXPECT_GE(value, -3);
+			EXPECT_LE(value, 2);
+		}
+
+		EXPECT_EQ(random.NextInt(-3, -3), -3);
+		EXPECT_NO_THROW(random.NextInt(std::numeric_limits<int>::min(), std::numeric_limits<int>::max()));
+		EXPECT_THROW(random.NextInt(2, 1), std::invalid_argument);
+	}
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+#include "DiceCalculator/Xoshiro256Random.h"
+
+namespace DiceCalculator
+{
+	TEST(Xoshiro256RandomTest, NextUInt64MatchesReferenceImplementation)
+	{
+		// First outputs of the reference xoshiro256plusplus.c started from the state { 1, 2, 3, 4 }.
+		Xoshiro256Random random(Xoshiro256Random::State{ 1, 2, 3, 4 });
+		EXPECT_EQ(random.NextUInt64(), 0x2800001ull);
+		EXPECT_EQ(random.NextUInt64(), 0x3800067ull);
+		EXPECT_EQ(random.NextUInt64(), 0xcc00003800067ull);
+		EXPECT_EQ(random.NextUInt64(), 0xcc201994400b2ull);
+	}
+
+	TEST(Xoshiro256RandomTest, NextUInt32SplitsEachOutputIntoHalves)
+	{
+		Xoshiro256Random random(Xoshiro256Random::State{ 1, 2, 3, 4 });
+		EXPECT_EQ(random.NextUInt32(), 0u);
+		EXPECT_EQ(random.NextUInt32(), 0x2800001u);
+		EXPECT_EQ(random.NextUInt32(), 0u);
+		EXPECT_EQ(random.NextUInt32(), 0x3800067u);
+	}
+
+	TEST(Xoshiro256RandomTest, SameSeedRepeatsAndOtherSeedsDiffer)
+	{
+		Xoshiro256Random first(1234);
+		Xoshiro256Random second(1234);
+		Xoshiro256Random otherSeed(1235);
+
+		int differentSeed = 0;
+		for (int i = 0; i < 64; ++i)
+		{
+			const std::uint64_t value = first.NextUInt64();
+			EXPECT_EQ(value, second.NextUInt64());
+			differentSeed += value != otherSeed.NextUInt64() ? 1 : 0;
+		}
+		EXPECT_GT(differentSeed, 60);
+	}
+
+	TEST(Xoshiro256RandomTest, FillMatchesNextInt)
+	{
+		Xoshiro256Random filled(99);
+		Xoshiro256Random drawn(99);
+		std::vector<int> faces(1000);
+		filled.Fill(faces, 1, 7);
+
+		for (const int face : faces)
+		{
+			EXPECT_EQ(face, drawn.NextInt(1, 7));
+		}
+	}
+
+	TEST(Xoshiro256RandomTest, SumDiceAddsOneFillPerDie)
+	{
+		// More sums than one chunk of the default SumDice, so the chunks are drawn one after another.
+		Xoshiro256Random summed(7);
+		Xoshiro256Random filled(7);
+		std::vector<int> sums(300);
+		std::vector<int> firstFaces(300);
+		summed.SumDice(sums, firstFaces, 3, 6);
+
+		std::vector<int> expectedSums;
+		std::vector<int> expectedFirstFaces;
+		for (const std::size_t chunk : { 256u, 44u })
+		{
+			std::vector<int> chunkSums(chunk, 0);
+			std::vector<int> faces(chunk);
+			for (int die = 0; die < 3; ++die)
+			{
+				filled.Fill(faces, 1, 6);
+				for (std::size_t i = 0; i < chunk; ++i)
+				{
+					chunkSums[i] += faces[i];
+				}
+				if (die == 0)
+				{
+					expectedFirstFaces.insert(expectedFirstFaces.end(), faces.begin(), faces.end());
+				}
+			}
+			expectedSums.insert(expectedSums.end(), chunkSums.begin(), chunkSums.end());
+		}
+
+		EXPECT_EQ(sums, expectedSums);
+		EXPECT_EQ(firstFaces, expectedFirstFaces);
+	}
+
+	TEST(Xoshiro256RandomTest, BoundedValuesCoverRangeUniformly)
+	{
+		Xoshiro256Random random(42);
+		std::vector<int> faces(60000);
+		random.Fill(faces, 1, 6);
+
+		std::array<int, 6> counts = {};
+		for (const int face : faces)
+		{
+			ASSERT_GE(face, 1);
+			ASSERT_LE(face, 6);
+			++counts[static_cast<std::size_t>(face - 1)];
+		}
+		for (const int count : counts)
+		{
+			EXPECT_NEAR(count, 10000, 500);
+		}
+
+		EXPECT_EQ(random.NextInt(-3, -3), -3);
+		EXPECT_NO_THROW(random.NextInt(std::numeric_limits<int>::min(), std::numeric_limits<int>::max()));
+		EXPECT_THROW(random.NextInt(2, 1), std::invalid_argument);
+	}
+
+	TEST(Xoshiro256RandomTest, AllZeroStateIsRejected)
+	{
+		EXPECT_THROW(Xoshiro256Random(Xoshiro256Random::State{ 0, 0, 0, 0 }), std::invalid_argument);
+	}
+}